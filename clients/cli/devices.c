@@ -397,6 +397,57 @@ const NmcMetaGenericInfo *const metagen_device_detail_connections[_NMC_GENERIC_I
 
 /*****************************************************************************/
 
+static gconstpointer
+_metagen_device_detail_activation_timeline_get_fcn (NMC_META_GENERIC_INFO_GET_FCN_ARGS)
+{
+	NMDevice *d = target;
+	GVariant *timeline;
+	GVariantIter iter;
+	const char *event;
+	guint32 msec;
+	char **arr = NULL;
+	guint i;
+
+	NMC_HANDLE_COLOR (NM_META_COLOR_NONE);
+
+	switch (info->info_type) {
+	case NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_ACTIVATION_TIMELINE_EVENTS:
+		if (!NM_FLAGS_HAS (get_flags, NM_META_ACCESSOR_GET_FLAGS_ACCEPT_STRV))
+			return NULL;
+
+		timeline = nm_device_get_activation_timeline (d);
+		if (!timeline)
+			goto arr_out;
+
+		arr = g_new (char *, g_variant_n_children (timeline) + 1);
+		i = 0;
+		g_variant_iter_init (&iter, timeline);
+		while (g_variant_iter_next (&iter, "(&su)", &event, &msec))
+			arr[i++] = g_strdup_printf ("%s +%ums", event, (guint) msec);
+		arr[i] = NULL;
+		goto arr_out;
+
+	default:
+		break;
+	}
+
+	g_return_val_if_reached (NULL);
+
+arr_out:
+	NM_SET_OUT (out_is_default, !arr || !arr[0]);
+	*out_flags |= NM_META_ACCESSOR_GET_OUT_FLAGS_STRV;
+	*out_to_free = arr;
+	return arr;
+}
+
+const NmcMetaGenericInfo *const metagen_device_detail_activation_timeline[_NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_ACTIVATION_TIMELINE_NUM + 1] = {
+#define _METAGEN_DEVICE_DETAIL_ACTIVATION_TIMELINE(type, name) \
+	[type] = NMC_META_GENERIC(name, .info_type = type, .get_fcn = _metagen_device_detail_activation_timeline_get_fcn)
+	_METAGEN_DEVICE_DETAIL_ACTIVATION_TIMELINE (NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_ACTIVATION_TIMELINE_EVENTS, "EVENTS"),
+};
+
+/*****************************************************************************/
+
 static gconstpointer
 _metagen_device_detail_capabilities_get_fcn (NMC_META_GENERIC_INFO_GET_FCN_ARGS)
 {
@@ -693,6 +744,7 @@ const NmcMetaGenericInfo *const nmc_fields_dev_show_sections[] = {
 	NMC_META_GENERIC_WITH_NESTED ("VLAN",              nmc_fields_dev_show_vlan_prop + 1),      /* 15 */
 	NMC_META_GENERIC_WITH_NESTED ("BLUETOOTH",         nmc_fields_dev_show_bluetooth + 1),      /* 16 */
 	NMC_META_GENERIC_WITH_NESTED ("CONNECTIONS",       metagen_device_detail_connections),      /* 17 */
+	NMC_META_GENERIC_WITH_NESTED ("ACTIVATION-TIMELINE", metagen_device_detail_activation_timeline), /* 18 */
 	NULL,
 };
 #define NMC_FIELDS_DEV_SHOW_SECTIONS_COMMON  "GENERAL.DEVICE,GENERAL.TYPE,GENERAL.HWADDR,GENERAL.MTU,GENERAL.STATE,"\
@@ -1697,6 +1749,22 @@ show_device_info (NMDevice *device, NmCli *nmc)
 			was_output = TRUE;
 			continue;
 		}
+
+		if (nmc_fields_dev_show_sections[section_idx]->nested == metagen_device_detail_activation_timeline) {
+			if (nm_device_get_activation_timeline (device)) {
+				gs_free char *f = section_fld ? g_strdup_printf ("ACTIVATION-TIMELINE.%s", section_fld) : NULL;
+
+				nmc_print (&nmc->nmc_config,
+				           (gpointer[]) { device, NULL },
+				           NULL,
+				           NULL,
+				           NMC_META_GENERIC_GROUP ("ACTIVATION-TIMELINE", metagen_device_detail_activation_timeline, N_("NAME")),
+				           f,
+				           NULL);
+				was_output = TRUE;
+			}
+			continue;
+		}
 	}
 
 	if (sections_array)
@@ -183,6 +183,7 @@ complete_fields (const char *option, const char *prefix)
 	complete_field (h, metagen_device_status);
 	complete_field (h, metagen_device_detail_general);
 	complete_field (h, metagen_device_detail_connections);
+	complete_field (h, metagen_device_detail_activation_timeline);
 	complete_field (h, metagen_device_detail_capabilities);
 	complete_field (h, metagen_device_detail_wired_properties);
 	complete_field (h, metagen_device_detail_wifi_properties);
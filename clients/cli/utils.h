@@ -222,6 +222,9 @@ typedef enum {
 	NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_INTERFACE_FLAGS_CARRIER,
 	_NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_INTERFACE_FLAGS_NUM,
 
+	NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_ACTIVATION_TIMELINE_EVENTS = 0,
+	_NMC_GENERIC_INFO_TYPE_DEVICE_DETAIL_ACTIVATION_TIMELINE_NUM,
+
 } NmcGenericInfoType;
 
 #define NMC_HANDLE_COLOR(color) \
@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Compares the latency of "nmcli -t device" via the system bus and via the
+# private client socket of NetworkManager. The latter requires
+# "private-client-socket=yes" in the [main] section of NetworkManager.conf
+# and must run as root.
+#
+# Usage: nm-benchmark-nmcli.sh [ITERATIONS] [NMCLI]
+
+set -e
+
+N="${1:-200}"
+NMCLI="${2:-nmcli}"
+
+if [ "$(id -u)" != 0 ]; then
+    echo "must run as root" >&2
+    exit 1
+fi
+
+if [ ! -S /run/NetworkManager/private-client ]; then
+    echo "/run/NetworkManager/private-client does not exist. Enable \"main.private-client-socket\"" >&2
+    exit 1
+fi
+
+now_us() {
+    echo $(( $(date +%s%N) / 1000 ))
+}
+
+run() {
+    local name="$1"
+    local start
+    local end
+    local i
+
+    shift
+    "$@" "$NMCLI" -t device > /dev/null
+
+    start="$(now_us)"
+    for (( i = 0; i < N; i++ )); do
+        "$@" "$NMCLI" -t device > /dev/null
+    done
+    end="$(now_us)"
+
+    printf "%-16s %6d calls, %8.2f ms per call\n" \
+           "$name" "$N" "$(echo "($end - $start) / $N / 1000" | bc -l)"
+}
+
+run "system bus"     env -u LIBNM_USE_PRIVATE_SOCKET
+run "private socket" env LIBNM_USE_PRIVATE_SOCKET=1
@@ -46,20 +46,32 @@ _get_cipher_info (NMCryptoCipherType cipher,
 gboolean
 _nm_crypto_init (GError **error)
 {
-	static gboolean initialized = FALSE;
+	static int initialized = FALSE;
+	G_LOCK_DEFINE_STATIC (init_lock);
 
-	if (initialized)
+	/* this may be called from multiple threads at the same time, for
+	 * example by the keyfile plugin parsing profiles on worker threads. */
+	if (g_atomic_int_get (&initialized))
 		return TRUE;
 
+	G_LOCK (init_lock);
+
+	if (initialized) {
+		G_UNLOCK (init_lock);
+		return TRUE;
+	}
+
 	if (gnutls_global_init () != 0) {
 		gnutls_global_deinit ();
+		G_UNLOCK (init_lock);
 		g_set_error_literal (error, NM_CRYPTO_ERROR,
 		                     NM_CRYPTO_ERROR_FAILED,
 		                     _("Failed to initialize the crypto engine."));
 		return FALSE;
 	}
 
-	initialized = TRUE;
+	g_atomic_int_set (&initialized, TRUE);
+	G_UNLOCK (init_lock);
 	return TRUE;
 }
 
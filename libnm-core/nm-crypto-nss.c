@@ -51,12 +51,22 @@ _get_cipher_info (NMCryptoCipherType cipher,
 gboolean
 _nm_crypto_init (GError **error)
 {
-	static gboolean initialized = FALSE;
+	static int initialized = FALSE;
+	G_LOCK_DEFINE_STATIC (init_lock);
 	SECStatus ret;
 
-	if (initialized)
+	/* this may be called from multiple threads at the same time, for
+	 * example by the keyfile plugin parsing profiles on worker threads. */
+	if (g_atomic_int_get (&initialized))
 		return TRUE;
 
+	G_LOCK (init_lock);
+
+	if (initialized) {
+		G_UNLOCK (init_lock);
+		return TRUE;
+	}
+
 	PR_Init (PR_USER_THREAD, PR_PRIORITY_NORMAL, 1);
 	ret = NSS_NoDB_Init (NULL);
 	if (ret != SECSuccess) {
@@ -65,6 +75,7 @@ _nm_crypto_init (GError **error)
 		             _("Failed to initialize the crypto engine: %d."),
 		             PR_GetError ());
 		PR_Cleanup ();
+		G_UNLOCK (init_lock);
 		return FALSE;
 	}
 
@@ -76,7 +87,8 @@ _nm_crypto_init (GError **error)
 	SEC_PKCS12EnableCipher (PKCS12_DES_EDE3_168, 1);
 	SEC_PKCS12SetPreferredCipher (PKCS12_DES_EDE3_168, 1);
 
-	initialized = TRUE;
+	g_atomic_int_set (&initialized, TRUE);
+	G_UNLOCK (init_lock);
 	return TRUE;
 }
 
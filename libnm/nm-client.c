@@ -220,6 +220,7 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMClient,
 	PROP_CHECKPOINTS,
 	PROP_CAPABILITIES,
 	PROP_PERMISSIONS_STATE,
+	PROP_OBJECT_TYPES,
 );
 
 enum {
@@ -252,6 +253,16 @@ enum {
 	_PROPERTY_AO_IDX_NM_NUM,
 };
 
+/* With NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS, these groups of NMClient's
+ * properties are only processed after they were accessed the first time. */
+typedef enum {
+	LAZY_GROUP_NONE               = 0,
+	LAZY_GROUP_DEVICES            = (1LL << 0),
+	LAZY_GROUP_ACTIVE_CONNECTIONS = (1LL << 1),
+	LAZY_GROUP_CHECKPOINTS        = (1LL << 2),
+	LAZY_GROUP_ALL                = (1LL << 3) - 1,
+} LazyGroup;
+
 typedef struct {
 	struct udev *udev;
 	GMainContext *main_context;
@@ -279,6 +290,16 @@ typedef struct {
 	guint8 *permissions;
 	GCancellable *permissions_cancellable;
 
+	/* loading lazy objects is deferred to this idle source while
+	 * we are handling D-Bus changes. */
+	GSource *lazy_idle_source;
+
+	/* the type names from NMClient:object-types, or NULL to track all. */
+	char **object_types;
+
+	/* the valid types from @object_types, zero terminated. */
+	GType *object_gtypes;
+
 	char *name_owner;
 	guint name_owner_changed_id;
 	guint dbsid_nm_object_manager;
@@ -290,14 +311,23 @@ typedef struct {
 
 	NMClientInstanceFlags instance_flags:3;
 
+	LazyGroup lazy_loaded:3;
+	LazyGroup lazy_pending:3;
+
 	NMTernary permissions_state:3;
 
 	bool instance_flags_constructed:1;
 
 	bool udev_inited:1;
 	bool notify_event_lst_changed:1;
+	bool dbus_connection_is_peer:1;
 	bool check_dbobj_visible_all:1;
 	bool nm_running:1;
+	bool handling_changes:1;
+
+	/* whether _lazy_instantiate() marked objects as wanted, that are not
+	 * yet instantiated. */
+	bool lazy_wanted_pending:1;
 
 	struct {
 		NMLDBusPropertyO property_o[_PROPERTY_O_IDX_NM_NUM];
@@ -372,6 +402,16 @@ static void name_owner_changed_cb (GDBusConnection *connection,
 
 static void name_owner_get_call (NMClient *self);
 
+static const char *
+_name_owner_get_bus_name (NMClientPrivate *priv)
+{
+	/* On a private connection, NetworkManager is the peer. Such messages have
+	 * no destination and signals have no sender. */
+	if (priv->dbus_connection_is_peer)
+		return NULL;
+	return priv->name_owner;
+}
+
 static void _set_nm_running (NMClient *self);
 
 /*****************************************************************************/
@@ -523,7 +563,7 @@ _nm_client_dbus_call_simple (NMClient *self,
 	dbus_context = nm_g_main_context_push_thread_default_if_necessary (priv->dbus_context);
 
 	g_dbus_connection_call (priv->dbus_connection,
-	                        priv->name_owner,
+	                        _name_owner_get_bus_name (priv),
 	                        object_path,
 	                        interface_name,
 	                        method_name,
@@ -631,7 +671,7 @@ _nm_client_dbus_call_sync (NMClient *self,
 	}
 
 	ret = g_dbus_connection_call_sync (priv->dbus_connection,
-	                                   priv->name_owner,
+	                                   _name_owner_get_bus_name (priv),
 	                                   object_path,
 	                                   interface_name,
 	                                   method_name,
@@ -712,7 +752,7 @@ _nm_client_set_property_sync_legacy (NMClient *self,
 	/* A synchronous D-Bus call that is not cancellable an ignores the return value.
 	 * This function only exists for backward compatibility. */
 	ret = g_dbus_connection_call_sync (priv->dbus_connection,
-	                                   priv->name_owner,
+	                                   _name_owner_get_bus_name (priv),
 	                                   object_path,
 	                                   DBUS_INTERFACE_PROPERTIES,
 	                                   "Set",
@@ -1498,6 +1538,115 @@ _dbobjs_get_nmobj_unpack_visible (NMClient *self,
 
 /*****************************************************************************/
 
+static LazyGroup
+_lazy_group_for_property (const NMLDBusMetaIface *meta_iface,
+                          guint dbus_property_idx)
+{
+	if (meta_iface != &_nml_dbus_meta_iface_nm)
+		return LAZY_GROUP_NONE;
+
+	switch (meta_iface->dbus_properties[dbus_property_idx].obj_properties_idx) {
+	case PROP_DEVICES:
+	case PROP_ALL_DEVICES:
+		return LAZY_GROUP_DEVICES;
+	case PROP_ACTIVE_CONNECTIONS:
+	case PROP_PRIMARY_CONNECTION:
+	case PROP_ACTIVATING_CONNECTION:
+		return LAZY_GROUP_ACTIVE_CONNECTIONS;
+	case PROP_CHECKPOINTS:
+		return LAZY_GROUP_CHECKPOINTS;
+	}
+	return LAZY_GROUP_NONE;
+}
+
+static gboolean
+_lazy_group_is_pending (NMClient *self,
+                        const NMLDBusMetaIface *meta_iface,
+                        guint dbus_property_idx)
+{
+	LazyGroup group;
+
+	group = _lazy_group_for_property (meta_iface, dbus_property_idx);
+	return    group != LAZY_GROUP_NONE
+	       && !NM_FLAGS_ALL (NM_CLIENT_GET_PRIVATE (self)->lazy_loaded, group);
+}
+
+static gboolean
+_nm_client_type_is_tracked (NMClient *self,
+                            GType gtype)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+	const GType *t;
+
+	if (!priv->object_types)
+		return TRUE;
+
+	for (t = priv->object_gtypes; *t; t++) {
+		if (g_type_is_a (gtype, *t))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/* whether @dbobj is on D-Bus, but we intentionally don't have an NMObject
+ * for it. Either because of NMClient:object-types, or because it was not yet
+ * needed with NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS. */
+static gboolean
+_dbobjs_dbobj_is_skipped (NMClient *self,
+                          NMLDBusObject *dbobj)
+{
+	if (   dbobj->nmobj
+	    || dbobj->obj_state != NML_DBUS_OBJ_STATE_ON_DBUS)
+		return FALSE;
+
+	return    dbobj->nmobj_untracked
+	       || NM_FLAGS_HAS (NM_CLIENT_GET_PRIVATE (self)->instance_flags, NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS);
+}
+
+static void
+_dbobjs_dbobj_set_untracked (NMClient *self,
+                             NMLDBusObject *dbobj,
+                             GType gtype)
+{
+	NMLDBusObjIfaceData *db_iface_data;
+	NMLDBusObjPropData *db_prop_data;
+
+	NML_NMCLIENT_LOG_T (self, "[%s]: ignore D-Bus object of untracked type %s",
+	                    dbobj->dbus_path->str,
+	                    g_type_name (gtype));
+
+	dbobj->nmobj_untracked = TRUE;
+
+	/* we will never need the cached property values. */
+	c_list_for_each_entry (db_iface_data, &dbobj->iface_lst_head, iface_lst) {
+		if (!db_iface_data->dbus_iface_is_wellknown)
+			continue;
+		while ((db_prop_data = c_list_first_entry (&db_iface_data->changed_prop_lst_head, NMLDBusObjPropData, changed_prop_lst))) {
+			c_list_unlink (&db_prop_data->changed_prop_lst);
+			nm_clear_pointer (&db_prop_data->prop_data_value, g_variant_unref);
+		}
+	}
+}
+
+static gboolean
+_dbobjs_dbobj_want_nmobj (NMClient *self,
+                          NMLDBusObject *dbobj)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+
+	if (!NM_FLAGS_HAS (priv->instance_flags, NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS))
+		return TRUE;
+
+	/* With lazy objects, we only create an NMObject if something references
+	 * the D-Bus object (or the user explicitly asked for it). Otherwise, the
+	 * properties stay cached in the NMLDBusObject. */
+	return    dbobj->nmobj_wanted
+	       || !c_list_is_empty (&dbobj->watcher_lst_head)
+	       || NM_IN_SET (dbobj->dbus_path, _dbus_path_nm,
+	                                       _dbus_path_settings,
+	                                       _dbus_path_dns_manager);
+}
+
 static gpointer
 _dbobjs_obj_watcher_register_o (NMClient *self,
                                 NMLDBusObject *dbobj,
@@ -1511,6 +1660,14 @@ _dbobjs_obj_watcher_register_o (NMClient *self,
 	nm_assert (notify_fcn);
 	nm_assert (struct_size > sizeof (NMLDBusObjWatcher));
 
+	if (   !dbobj->nmobj
+	    && dbobj->obj_state == NML_DBUS_OBJ_STATE_ON_DBUS
+	    && !_dbobjs_dbobj_want_nmobj (self, dbobj)) {
+		/* the object is about to get its first watcher. It was skipped
+		 * so far, and needs another pass to create the NMObject. */
+		nml_dbus_object_obj_changed_link (self, dbobj, NML_DBUS_OBJ_CHANGED_TYPE_DBUS);
+	}
+
 	obj_watcher = g_malloc (struct_size);
 	obj_watcher->dbobj = dbobj;
 	obj_watcher->_priv.notify_fcn = notify_fcn;
@@ -1600,7 +1757,8 @@ nml_dbus_property_o_is_ready_fully (const NMLDBusPropertyO *pr_o)
 {
 	return    !pr_o->owner_dbobj
 	       || !pr_o->obj_watcher
-	       || pr_o->nmobj;
+	       || pr_o->nmobj
+	       || pr_o->obj_watcher->dbobj->nmobj_untracked;
 }
 
 static void
@@ -1631,7 +1789,9 @@ nml_dbus_property_o_notify_changed (NMLDBusPropertyO *pr_o,
 		goto done;
 
 	if (!pr_o->obj_watcher->dbobj->nmobj) {
-		if (pr_o->obj_watcher->dbobj->obj_state >= NML_DBUS_OBJ_STATE_ON_DBUS) {
+		if (pr_o->obj_watcher->dbobj->nmobj_untracked) {
+			/* we are not interested in this object type. */
+		} else if (pr_o->obj_watcher->dbobj->obj_state >= NML_DBUS_OBJ_STATE_ON_DBUS) {
 			NML_NMCLIENT_LOG_W (self, "[%s]: property %s references %s but object is not created",
 			                    pr_o->owner_dbobj->dbus_path->str,
 			                    pr_o->meta_iface->dbus_properties[pr_o->dbus_property_idx].dbus_property_name,
@@ -1948,7 +2108,9 @@ nml_dbus_property_ao_notify_changed (NMLDBusPropertyAO *pr_ao,
 		pr_ao_data->is_changed = FALSE;
 
 		if (!pr_ao_data->obj_watcher.dbobj->nmobj) {
-			if (pr_ao_data->obj_watcher.dbobj->obj_state >= NML_DBUS_OBJ_STATE_ON_DBUS) {
+			if (pr_ao_data->obj_watcher.dbobj->nmobj_untracked) {
+				/* we are not interested in this object type. */
+			} else if (pr_ao_data->obj_watcher.dbobj->obj_state >= NML_DBUS_OBJ_STATE_ON_DBUS) {
 				NML_NMCLIENT_LOG_W (self, "[%s]: property %s references %s but object is not created",
 				                    pr_ao->owner_dbobj->dbus_path->str,
 				                    pr_ao->meta_iface->dbus_properties[pr_ao->dbus_property_idx].dbus_property_name,
@@ -2580,6 +2742,13 @@ _obj_handle_dbus_iface_changes (NMClient *self,
 			nm_assert (db_prop_data < &db_iface_data->prop_datas[db_iface_data->dbus_iface.meta->n_dbus_properties]);
 			nm_assert (db_prop_data->prop_data_value);
 
+			i_prop = (db_prop_data - &db_iface_data->prop_datas[0]);
+
+			if (G_UNLIKELY (_lazy_group_is_pending (self, db_iface_data->dbus_iface.meta, i_prop))) {
+				/* keep the value until the property is accessed. See _lazy_load(). */
+				continue;
+			}
+
 			/* Currently NMLDBusObject forgets about the variant. Theoretically, it could cache
 			 * it, but there is no need because we update the property in nmobj (which extracts and
 			 * keeps the property value itself).
@@ -2589,7 +2758,6 @@ _obj_handle_dbus_iface_changes (NMClient *self,
 			 * instance. Unless that happens, we cache the last seen property values. */
 			prop_data_value = g_steal_pointer (&db_prop_data->prop_data_value);
 
-			i_prop = (db_prop_data - &db_iface_data->prop_datas[0]);
 			_obj_handle_dbus_prop_changes (self,
 			                               dbobj,
 			                               db_iface_data,
@@ -2631,7 +2799,9 @@ _obj_handle_dbus_changes (NMClient *self,
 	}
 
 	if (   G_UNLIKELY (!dbobj->nmobj)
-	    && !c_list_is_empty (&dbobj->iface_lst_head)) {
+	    && !dbobj->nmobj_untracked
+	    && !c_list_is_empty (&dbobj->iface_lst_head)
+	    && _dbobjs_dbobj_want_nmobj (self, dbobj)) {
 
 		/* Try to create a NMObject for this D-Bus object. Note that we detect the type
 		 * based on the interfaces that it has, and if we make a choice once, we don't
@@ -2670,6 +2840,11 @@ _obj_handle_dbus_changes (NMClient *self,
 				curr_prio = db_iface_data->dbus_iface.meta->interface_prio;
 				gtype = db_iface_data->dbus_iface.meta->get_type_fcn ();
 			}
+			if (   gtype != G_TYPE_NONE
+			    && !_nm_client_type_is_tracked (self, gtype)) {
+				_dbobjs_dbobj_set_untracked (self, dbobj, gtype);
+				gtype = G_TYPE_NONE;
+			}
 			if (gtype != G_TYPE_NONE) {
 				dbobj->nmobj = g_object_new (gtype, NULL);
 
@@ -2727,6 +2902,11 @@ _obj_handle_dbus_changes (NMClient *self,
 		}
 	}
 
+	if (c_list_is_empty (&dbobj->iface_lst_head)) {
+		dbobj->nmobj_wanted = FALSE;
+		dbobj->nmobj_untracked = FALSE;
+	}
+
 	nml_dbus_object_obj_changed_link (self, dbobj, NML_DBUS_OBJ_CHANGED_TYPE_NMOBJ);
 }
 
@@ -2795,9 +2975,15 @@ _dbus_handle_obj_changed_dbus (NMClient *self,
 	NMClientPrivate *priv;
 	NMLDBusObject *dbobj;
 	CList obj_changed_tmp_lst_head = C_LIST_INIT (obj_changed_tmp_lst_head);
+	gboolean handling_changes;
 
 	priv = NM_CLIENT_GET_PRIVATE (self);
 
+	handling_changes = priv->handling_changes;
+	priv->handling_changes = TRUE;
+
+again:
+
 	/* We move the changed list onto a temporary list and consume that.
 	 * Note that nml_dbus_object_obj_changed_consume() will move the object
 	 * back to the original list if there are changes of another type.
@@ -2831,17 +3017,29 @@ _dbus_handle_obj_changed_dbus (NMClient *self,
 		}
 	}
 
-	/* D-Bus changes can only be enqueued in an earlier stage. We don't expect
-	 * anymore changes of type D-Bus at this point. */
-	nm_assert (!nml_dbus_object_obj_changed_any_linked (self, NML_DBUS_OBJ_CHANGED_TYPE_DBUS));
+	/* With lazy objects, registering a watcher can enqueue an object that
+	 * we skipped earlier. Otherwise, D-Bus changes can only be enqueued in
+	 * an earlier stage. */
+	if (nml_dbus_object_obj_changed_any_linked (self, NML_DBUS_OBJ_CHANGED_TYPE_DBUS)) {
+		nm_assert (NM_FLAGS_HAS (priv->instance_flags, NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS));
+		goto again;
+	}
+
+	priv->handling_changes = handling_changes;
 }
 
+static void _lazy_idle_schedule (NMClient *self);
+
 static void
 _dbus_handle_changes_commit (NMClient *self,
                              gboolean allow_init_start_check_complete)
 {
 	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
 	nm_auto_pop_gmaincontext GMainContext *dbus_context = NULL;
+	gboolean handling_changes;
+
+	handling_changes = priv->handling_changes;
+	priv->handling_changes = TRUE;
 
 	_dbus_handle_obj_changed_nmobj (self);
 
@@ -2853,6 +3051,15 @@ _dbus_handle_changes_commit (NMClient *self,
 
 	if (allow_init_start_check_complete)
 		_init_start_check_complete (self);
+
+	priv->handling_changes = handling_changes;
+
+	/* a getter may have deferred the loading of lazy objects while we were
+	 * handling changes. Now we are done, so load them. */
+	if (   !priv->handling_changes
+	    && (   priv->lazy_pending != LAZY_GROUP_NONE
+	        || priv->lazy_wanted_pending))
+		_lazy_idle_schedule (self);
 }
 
 static void
@@ -2864,6 +3071,170 @@ _dbus_handle_changes (NMClient *self,
 	_dbus_handle_changes_commit (self, allow_init_start_check_complete);
 }
 
+/*****************************************************************************/
+
+static gboolean _lazy_idle_cb (gpointer user_data);
+
+static void
+_lazy_idle_schedule (NMClient *self)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+
+	if (priv->lazy_idle_source)
+		return;
+
+	priv->lazy_idle_source = nm_g_idle_source_new (G_PRIORITY_DEFAULT_IDLE,
+	                                               _lazy_idle_cb,
+	                                               self,
+	                                               NULL);
+	g_source_attach (priv->lazy_idle_source, priv->main_context);
+}
+
+/* The getters may be called from a signal handler, while we are handling
+ * D-Bus changes. Processing more changes at that point would emit signals
+ * in the middle of emitting others. Instead, the getter returns what we
+ * have right now and the lazy objects are loaded on idle. */
+static gboolean
+_lazy_defer (NMClient *self)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+
+	if (!priv->handling_changes)
+		return FALSE;
+
+	_lazy_idle_schedule (self);
+	return TRUE;
+}
+
+/* _lazy_load() processes the cached D-Bus properties of NMClient for @groups,
+ * the first time they are accessed. This creates the referenced objects
+ * and emits the corresponding signals (like "device-added"). */
+static void
+_lazy_load (NMClient *self,
+            LazyGroup groups)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+	NMLDBusObjIfaceData *db_iface_data;
+	gboolean any = FALSE;
+	guint i_prop;
+
+	if (G_LIKELY (NM_FLAGS_ALL (priv->lazy_loaded, groups)))
+		return;
+
+	if (   !self->obj_base.is_disposing
+	    && _lazy_defer (self)) {
+		priv->lazy_pending |= (groups & ~priv->lazy_loaded);
+		return;
+	}
+
+	groups &= ~priv->lazy_loaded;
+	priv->lazy_loaded |= groups;
+
+	if (   self->obj_base.is_disposing
+	    || !priv->dbobj_nm)
+		return;
+
+	db_iface_data = nml_dbus_object_iface_data_get (priv->dbobj_nm, NM_DBUS_INTERFACE, FALSE);
+	if (   !db_iface_data
+	    || db_iface_data->iface_removed)
+		return;
+
+	for (i_prop = 0; i_prop < db_iface_data->dbus_iface.meta->n_dbus_properties; i_prop++) {
+		NMLDBusObjPropData *db_prop_data = &db_iface_data->prop_datas[i_prop];
+
+		if (!db_prop_data->prop_data_value)
+			continue;
+		if (!NM_FLAGS_ANY (_lazy_group_for_property (db_iface_data->dbus_iface.meta, i_prop), groups))
+			continue;
+		nm_c_list_move_tail (&db_iface_data->changed_prop_lst_head, &db_prop_data->changed_prop_lst);
+		any = TRUE;
+	}
+
+	if (!any)
+		return;
+
+	NML_NMCLIENT_LOG_T (self, "load lazy properties (0x%x)", (guint) groups);
+	nml_dbus_object_obj_changed_link (self, priv->dbobj_nm, NML_DBUS_OBJ_CHANGED_TYPE_DBUS);
+	_dbus_handle_changes (self, "lazy-load", FALSE);
+}
+
+/* _lazy_instantiate() creates the NMObject for @dbus_path, if it was
+ * not yet created due to NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS. */
+static void
+_lazy_instantiate (NMClient *self,
+                   const char *dbus_path)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+	NMLDBusObject *dbobj;
+
+	if (!NM_FLAGS_HAS (priv->instance_flags, NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS))
+		return;
+
+	if (self->obj_base.is_disposing)
+		return;
+
+	dbobj = _dbobjs_dbobj_get_s (self, dbus_path);
+	if (   !dbobj
+	    || dbobj->nmobj
+	    || dbobj->nmobj_wanted
+	    || dbobj->obj_state != NML_DBUS_OBJ_STATE_ON_DBUS)
+		return;
+
+	NML_NMCLIENT_LOG_T (self, "[%s]: instantiate lazy object", dbobj->dbus_path->str);
+	dbobj->nmobj_wanted = TRUE;
+
+	/* _lazy_idle_cb() picks up the object. */
+	if (_lazy_defer (self)) {
+		priv->lazy_wanted_pending = TRUE;
+		return;
+	}
+
+	nml_dbus_object_obj_changed_link (self, dbobj, NML_DBUS_OBJ_CHANGED_TYPE_DBUS);
+	_dbus_handle_changes (self, "lazy-instantiate", FALSE);
+}
+
+static gboolean
+_lazy_idle_cb (gpointer user_data)
+{
+	NMClient *self = user_data;
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+	NMLDBusObject *dbobj;
+	LazyGroup groups;
+	gboolean wanted_pending;
+	gboolean any = FALSE;
+
+	nm_clear_g_source_inst (&priv->lazy_idle_source);
+
+	if (priv->handling_changes) {
+		/* we are in a nested main loop of a signal handler. Don't spin,
+		 * _dbus_handle_changes_commit() schedules us again when done. */
+		return G_SOURCE_REMOVE;
+	}
+
+	groups = priv->lazy_pending;
+	priv->lazy_pending = LAZY_GROUP_NONE;
+	wanted_pending = priv->lazy_wanted_pending;
+	priv->lazy_wanted_pending = FALSE;
+
+	if (groups != LAZY_GROUP_NONE)
+		_lazy_load (self, groups);
+
+	if (!wanted_pending)
+		return G_SOURCE_REMOVE;
+
+	c_list_for_each_entry (dbobj, &priv->dbus_objects_lst_head_on_dbus, dbus_objects_lst) {
+		if (   dbobj->nmobj_wanted
+		    && !dbobj->nmobj) {
+			nml_dbus_object_obj_changed_link (self, dbobj, NML_DBUS_OBJ_CHANGED_TYPE_DBUS);
+			any = TRUE;
+		}
+	}
+	if (any)
+		_dbus_handle_changes (self, "lazy-instantiate", FALSE);
+
+	return G_SOURCE_REMOVE;
+}
+
 static gboolean
 _dbus_handle_properties_changed (NMClient *self,
                                  const char *log_context,
@@ -2906,6 +3277,13 @@ _dbus_handle_properties_changed (NMClient *self,
 
 	NM_SET_OUT (inout_dbobj, dbobj);
 
+	if (   dbobj
+	    && dbobj->nmobj_untracked
+	    && !allow_add_iface) {
+		/* we don't care about property changes of this object. */
+		return TRUE;
+	}
+
 	if (!db_iface_data) {
 		if (allow_add_iface)
 			NML_NMCLIENT_LOG_E (self, "%s: [%s] too many interfaces on object. Something is very wrong", log_context, object_path);
@@ -2918,7 +3296,8 @@ _dbus_handle_properties_changed (NMClient *self,
 
 	if (!db_iface_data->dbus_iface_is_wellknown)
 		NML_NMCLIENT_LOG_W (self, "%s: [%s] ignore unknown interface %s", log_context, object_path, interface_name);
-	else if (changed_properties) {
+	else if (   changed_properties
+	         && !dbobj->nmobj_untracked) {
 		GVariantIter iter_prop;
 		const char *property_name;
 		GVariant *property_value_tmp;
@@ -3267,6 +3646,10 @@ _dbus_settings_updated_cb (GDBusConnection *connection,
 
 	dbobj = _dbobjs_dbobj_get_s (self, object_path);
 
+	if (   dbobj
+	    && _dbobjs_dbobj_is_skipped (self, dbobj))
+		return;
+
 	if (   !dbobj
 	    || !NM_IS_REMOTE_CONNECTION (dbobj->nmobj)) {
 		NML_NMCLIENT_LOG_W (self, "%s: [%s] ignore Updated signal for non-existing setting",
@@ -3311,6 +3694,10 @@ _dbus_nm_connection_active_state_changed_cb (GDBusConnection *connection,
 
 	dbobj = _dbobjs_dbobj_get_s (self, object_path);
 
+	if (   dbobj
+	    && _dbobjs_dbobj_is_skipped (self, dbobj))
+		return;
+
 	if (   !dbobj
 	    || !NM_IS_ACTIVE_CONNECTION (dbobj->nmobj)) {
 		NML_NMCLIENT_LOG_E (self, "%s: [%s] ignore StateChanged signal for non-existing active connection",
@@ -3361,6 +3748,10 @@ _dbus_nm_vpn_connection_state_changed_cb (GDBusConnection *connection,
 
 	dbobj = _dbobjs_dbobj_get_s (self, object_path);
 
+	if (   dbobj
+	    && _dbobjs_dbobj_is_skipped (self, dbobj))
+		return;
+
 	if (   !dbobj
 	    || !NM_IS_VPN_CONNECTION (dbobj->nmobj)) {
 		NML_NMCLIENT_LOG_E (self, "%s: [%s] ignore VpnStateChanged signal for non-existing vpn connection",
@@ -3763,6 +4154,8 @@ _request_wait_start (GTask *task_take,
 
 	self = g_task_get_source_object (task);
 
+	_lazy_instantiate (self, dbus_path);
+
 	dbobj = _dbobjs_get_nmobj (self, dbus_path, gtype);
 
 	if (!dbobj) {
@@ -3992,6 +4385,7 @@ nm_client_get_object_by_path (NMClient *client,
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 	g_return_val_if_fail (dbus_path, NULL);
 
+	_lazy_instantiate (client, dbus_path);
 	return _dbobjs_get_nmobj_unpack_visible (client, dbus_path, G_TYPE_NONE);
 }
 
@@ -4706,6 +5100,7 @@ nm_client_get_devices (NMClient *client)
 {
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 
+	_lazy_load (client, LAZY_GROUP_DEVICES);
 	return nml_dbus_property_ao_get_objs_as_ptrarray (&NM_CLIENT_GET_PRIVATE (client)->nm.property_ao[PROPERTY_AO_IDX_DEVICES]);
 }
 
@@ -4734,6 +5129,7 @@ nm_client_get_all_devices (NMClient *client)
 {
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 
+	_lazy_load (client, LAZY_GROUP_DEVICES);
 	return nml_dbus_property_ao_get_objs_as_ptrarray (&NM_CLIENT_GET_PRIVATE (client)->nm.property_ao[PROPERTY_AO_IDX_ALL_DEVICES]);
 }
 
@@ -4752,6 +5148,7 @@ nm_client_get_device_by_path (NMClient *client, const char *object_path)
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 	g_return_val_if_fail (object_path, NULL);
 
+	_lazy_instantiate (client, object_path);
 	return _dbobjs_get_nmobj_unpack_visible (client, object_path, NM_TYPE_DEVICE);
 }
 
@@ -4803,6 +5200,7 @@ nm_client_get_active_connections (NMClient *client)
 {
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 
+	_lazy_load (client, LAZY_GROUP_ACTIVE_CONNECTIONS);
 	return nml_dbus_property_ao_get_objs_as_ptrarray (&NM_CLIENT_GET_PRIVATE (client)->nm.property_ao[PROPERTY_AO_IDX_ACTIVE_CONNECTIONS]);
 }
 
@@ -4830,6 +5228,7 @@ nm_client_get_primary_connection (NMClient *client)
 {
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 
+	_lazy_load (client, LAZY_GROUP_ACTIVE_CONNECTIONS);
 	return nml_dbus_property_o_get_obj (&NM_CLIENT_GET_PRIVATE (client)->nm.property_o[PROPERTY_O_IDX_NM_PRIMAY_CONNECTION]);
 }
 
@@ -4849,6 +5248,7 @@ nm_client_get_activating_connection (NMClient *client)
 {
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 
+	_lazy_load (client, LAZY_GROUP_ACTIVE_CONNECTIONS);
 	return nml_dbus_property_o_get_obj (&NM_CLIENT_GET_PRIVATE (client)->nm.property_o[PROPERTY_O_IDX_NM_ACTIVATING_CONNECTION]);
 }
 
@@ -6254,6 +6654,7 @@ nm_client_get_checkpoints (NMClient *client)
 {
 	g_return_val_if_fail (NM_IS_CLIENT (client), NULL);
 
+	_lazy_load (client, LAZY_GROUP_CHECKPOINTS);
 	return nml_dbus_property_ao_get_objs_as_ptrarray (&NM_CLIENT_GET_PRIVATE (client)->nm.property_ao[PROPERTY_AO_IDX_CHECKPOINTS]);
 }
 
@@ -6649,6 +7050,48 @@ nm_client_reload_finish (NMClient *client,
 
 /*****************************************************************************/
 
+/* NetworkManager may be configured to send the PropertiesChanged signals of
+ * high-volume interfaces only to clients that subscribed to them. Every
+ * subscriber costs the daemon a unicast message per signal, so only
+ * subscribe if the user asked for it, either explicitly or by choosing the
+ * object types to track. Then, subscribe to those that we track. Older
+ * daemons don't know the method, the error is ignored. */
+static void
+_init_subscribe_interfaces (NMClient *self)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+	const char *interfaces[4];
+	guint n = 0;
+
+	if (   !priv->object_types
+	    && !NM_FLAGS_HAS (priv->instance_flags, NM_CLIENT_INSTANCE_FLAGS_SUBSCRIBE_INTERFACES))
+		return;
+
+	if (_nm_client_type_is_tracked (self, NM_TYPE_ACCESS_POINT))
+		interfaces[n++] = NM_DBUS_INTERFACE_ACCESS_POINT;
+	if (_nm_client_type_is_tracked (self, NM_TYPE_IP4_CONFIG))
+		interfaces[n++] = NM_DBUS_INTERFACE_IP4_CONFIG;
+	if (_nm_client_type_is_tracked (self, NM_TYPE_IP6_CONFIG))
+		interfaces[n++] = NM_DBUS_INTERFACE_IP6_CONFIG;
+	interfaces[n] = NULL;
+
+	if (n == 0)
+		return;
+
+	g_dbus_connection_call (priv->dbus_connection,
+	                        _name_owner_get_bus_name (priv),
+	                        NM_DBUS_PATH,
+	                        NM_DBUS_INTERFACE,
+	                        "SubscribeInterfaces",
+	                        g_variant_new ("(^as)", interfaces),
+	                        NULL,
+	                        G_DBUS_CALL_FLAGS_NO_AUTO_START,
+	                        NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+	                        NULL,
+	                        NULL,
+	                        NULL);
+}
+
 static void
 _init_fetch_all (NMClient *self)
 {
@@ -6664,7 +7107,7 @@ _init_fetch_all (NMClient *self)
 	priv->get_managed_objects_cancellable = g_cancellable_new ();
 
 	priv->dbsid_nm_object_manager = nm_dbus_connection_signal_subscribe_object_manager (priv->dbus_connection,
-	                                                                                    priv->name_owner,
+	                                                                                    _name_owner_get_bus_name (priv),
 	                                                                                    "/org/freedesktop",
 	                                                                                    NULL,
 	                                                                                    _dbus_managed_objects_changed_cb,
@@ -6672,48 +7115,55 @@ _init_fetch_all (NMClient *self)
 	                                                                                    NULL);
 
 	priv->dbsid_dbus_properties_properties_changed = nm_dbus_connection_signal_subscribe_properties_changed (priv->dbus_connection,
-	                                                                                                         priv->name_owner,
+	                                                                                                         _name_owner_get_bus_name (priv),
 	                                                                                                         NULL,
 	                                                                                                         NULL,
 	                                                                                                         _dbus_properties_changed_cb,
 	                                                                                                         self,
 	                                                                                                         NULL);
 
-	priv->dbsid_nm_settings_connection_updated = g_dbus_connection_signal_subscribe (priv->dbus_connection,
-	                                                                                 priv->name_owner,
-	                                                                                 NM_DBUS_INTERFACE_SETTINGS_CONNECTION,
-	                                                                                 "Updated",
-	                                                                                 NULL,
-	                                                                                 NULL,
-	                                                                                 G_DBUS_SIGNAL_FLAGS_NONE,
-	                                                                                 _dbus_settings_updated_cb,
-	                                                                                 self,
-	                                                                                 NULL);
-
-	priv->dbsid_nm_connection_active_state_changed = g_dbus_connection_signal_subscribe (priv->dbus_connection,
-	                                                                                     priv->name_owner,
-	                                                                                     NM_DBUS_INTERFACE_ACTIVE_CONNECTION,
-	                                                                                     "StateChanged",
-	                                                                                     NULL,
-	                                                                                     NULL,
-	                                                                                     G_DBUS_SIGNAL_FLAGS_NONE,
-	                                                                                     _dbus_nm_connection_active_state_changed_cb,
-	                                                                                     self,
-	                                                                                     NULL);
-
-	priv->dbsid_nm_vpn_connection_state_changed = g_dbus_connection_signal_subscribe (priv->dbus_connection,
-	                                                                                  priv->name_owner,
-	                                                                                  NM_DBUS_INTERFACE_VPN_CONNECTION,
-	                                                                                  "VpnStateChanged",
-	                                                                                  NULL,
-	                                                                                  NULL,
-	                                                                                  G_DBUS_SIGNAL_FLAGS_NONE,
-	                                                                                  _dbus_nm_vpn_connection_state_changed_cb,
-	                                                                                  self,
-	                                                                                  NULL);
+	if (_nm_client_type_is_tracked (self, NM_TYPE_REMOTE_CONNECTION)) {
+		priv->dbsid_nm_settings_connection_updated = g_dbus_connection_signal_subscribe (priv->dbus_connection,
+		                                                                                 _name_owner_get_bus_name (priv),
+		                                                                                 NM_DBUS_INTERFACE_SETTINGS_CONNECTION,
+		                                                                                 "Updated",
+		                                                                                 NULL,
+		                                                                                 NULL,
+		                                                                                 G_DBUS_SIGNAL_FLAGS_NONE,
+		                                                                                 _dbus_settings_updated_cb,
+		                                                                                 self,
+		                                                                                 NULL);
+	}
+
+	if (   _nm_client_type_is_tracked (self, NM_TYPE_ACTIVE_CONNECTION)
+	    || _nm_client_type_is_tracked (self, NM_TYPE_VPN_CONNECTION)) {
+		priv->dbsid_nm_connection_active_state_changed = g_dbus_connection_signal_subscribe (priv->dbus_connection,
+		                                                                                     _name_owner_get_bus_name (priv),
+		                                                                                     NM_DBUS_INTERFACE_ACTIVE_CONNECTION,
+		                                                                                     "StateChanged",
+		                                                                                     NULL,
+		                                                                                     NULL,
+		                                                                                     G_DBUS_SIGNAL_FLAGS_NONE,
+		                                                                                     _dbus_nm_connection_active_state_changed_cb,
+		                                                                                     self,
+		                                                                                     NULL);
+	}
+
+	if (_nm_client_type_is_tracked (self, NM_TYPE_VPN_CONNECTION)) {
+		priv->dbsid_nm_vpn_connection_state_changed = g_dbus_connection_signal_subscribe (priv->dbus_connection,
+		                                                                                  _name_owner_get_bus_name (priv),
+		                                                                                  NM_DBUS_INTERFACE_VPN_CONNECTION,
+		                                                                                  "VpnStateChanged",
+		                                                                                  NULL,
+		                                                                                  NULL,
+		                                                                                  G_DBUS_SIGNAL_FLAGS_NONE,
+		                                                                                  _dbus_nm_vpn_connection_state_changed_cb,
+		                                                                                  self,
+		                                                                                  NULL);
+	}
 
 	priv->dbsid_nm_check_permissions = g_dbus_connection_signal_subscribe (priv->dbus_connection,
-	                                                                       priv->name_owner,
+	                                                                       _name_owner_get_bus_name (priv),
 	                                                                       NM_DBUS_INTERFACE,
 	                                                                       "CheckPermissions",
 	                                                                       NULL,
@@ -6723,8 +7173,10 @@ _init_fetch_all (NMClient *self)
 	                                                                       self,
 	                                                                       NULL);
 
+	_init_subscribe_interfaces (self);
+
 	g_dbus_connection_call (priv->dbus_connection,
-	                        priv->name_owner,
+	                        _name_owner_get_bus_name (priv),
 	                        "/org/freedesktop",
 	                        DBUS_INTERFACE_OBJECT_MANAGER,
 	                        "GetManagedObjects",
@@ -6856,11 +7308,13 @@ name_owner_changed (NMClient *self,
 
 		_assert_main_context_is_current_thread_default (self, dbus_context);
 
-		priv->name_owner_changed_id = nm_dbus_connection_signal_subscribe_name_owner_changed (priv->dbus_connection,
-		                                                                                      NM_DBUS_SERVICE,
-		                                                                                      name_owner_changed_cb,
-		                                                                                      self,
-		                                                                                      NULL);
+		if (!priv->dbus_connection_is_peer) {
+			priv->name_owner_changed_id = nm_dbus_connection_signal_subscribe_name_owner_changed (priv->dbus_connection,
+			                                                                                      NM_DBUS_SERVICE,
+			                                                                                      name_owner_changed_cb,
+			                                                                                      self,
+			                                                                                      NULL);
+		}
 		name_owner_get_call (self);
 	} else
 		dbus_context = nm_g_main_context_push_thread_default_if_necessary (priv->dbus_context);
@@ -6950,8 +7404,12 @@ name_owner_get_cb (GObject *source,
 
 	g_clear_object (&priv->name_owner_get_cancellable);
 
-	if (ret)
-		g_variant_get (ret, "(&s)", &name_owner);
+	if (ret) {
+		if (priv->dbus_connection_is_peer)
+			name_owner = NM_DBUS_SERVICE;
+		else
+			g_variant_get (ret, "(&s)", &name_owner);
+	}
 
 	name_owner_changed (self, name_owner);
 }
@@ -6964,6 +7422,24 @@ name_owner_get_call (NMClient *self)
 	nm_assert (!priv->name_owner_get_cancellable);
 	priv->name_owner_get_cancellable = g_cancellable_new ();
 
+	if (priv->dbus_connection_is_peer) {
+		/* There is no name owner on a private connection. Just check
+		 * that NetworkManager is still there. */
+		g_dbus_connection_call (priv->dbus_connection,
+		                        NULL,
+		                        "/org/freedesktop",
+		                        "org.freedesktop.DBus.Peer",
+		                        "Ping",
+		                        NULL,
+		                        G_VARIANT_TYPE ("()"),
+		                        G_DBUS_CALL_FLAGS_NONE,
+		                        NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+		                        priv->name_owner_get_cancellable,
+		                        name_owner_get_cb,
+		                        nm_utils_user_data_pack (self, g_object_ref (priv->context_busy_watcher)));
+		return;
+	}
+
 	g_dbus_connection_call (priv->dbus_connection,
 	                        DBUS_SERVICE_DBUS,
 	                        DBUS_PATH_DBUS,
@@ -7114,6 +7590,23 @@ _init_start_cancel_on_idle_cb (gpointer user_data)
 	return G_SOURCE_CONTINUE;
 }
 
+static void
+_dbus_connection_closed_cb (GDBusConnection *dbus_connection,
+                            gboolean remote_peer_vanished,
+                            GError *error,
+                            gpointer user_data)
+{
+	NMClient *self = user_data;
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (self);
+
+	NML_NMCLIENT_LOG_D (self, "private connection closed");
+
+	if (priv->name_owner_get_cancellable)
+		return;
+
+	name_owner_changed (self, NULL);
+}
+
 static void
 _init_start_with_bus (NMClient *self)
 {
@@ -7134,11 +7627,22 @@ _init_start_with_bus (NMClient *self)
 
 	_assert_main_context_is_current_thread_default (self, dbus_context);
 
-	priv->name_owner_changed_id = nm_dbus_connection_signal_subscribe_name_owner_changed (priv->dbus_connection,
-	                                                                                      NM_DBUS_SERVICE,
-	                                                                                      name_owner_changed_cb,
-	                                                                                      self,
-	                                                                                      NULL);
+	/* only connections to a message bus have a unique name. */
+	priv->dbus_connection_is_peer = !g_dbus_connection_get_unique_name (priv->dbus_connection);
+
+	if (priv->dbus_connection_is_peer) {
+		/* NetworkManager is gone when the private connection closes. */
+		g_signal_connect (priv->dbus_connection,
+		                  "closed",
+		                  G_CALLBACK (_dbus_connection_closed_cb),
+		                  self);
+	} else {
+		priv->name_owner_changed_id = nm_dbus_connection_signal_subscribe_name_owner_changed (priv->dbus_connection,
+		                                                                                      NM_DBUS_SERVICE,
+		                                                                                      name_owner_changed_cb,
+		                                                                                      self,
+		                                                                                      NULL);
+	}
 	name_owner_get_call (self);
 }
 
@@ -7167,6 +7671,41 @@ _init_start_bus_get_cb (GObject *source, GAsyncResult *result, gpointer user_dat
 	_notify (self, PROP_DBUS_CONNECTION);
 }
 
+static void
+_init_start_private_connection_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	NMClient *self = user_data;
+	NMClientPrivate *priv;
+	GDBusConnection *dbus_connection;
+	gs_free_error GError *error = NULL;
+
+	nm_assert (NM_IS_CLIENT (self));
+
+	dbus_connection = g_dbus_connection_new_for_address_finish (result, &error);
+
+	priv = NM_CLIENT_GET_PRIVATE (self);
+
+	if (!dbus_connection) {
+		if (nm_utils_error_is_cancelled (error)) {
+			_init_start_complete (self, g_steal_pointer (&error));
+			return;
+		}
+		NML_NMCLIENT_LOG_D (self, "cannot use private socket "NM_DBUS_PRIVATE_CLIENT_SOCKET": %s",
+		                    error->message);
+		g_bus_get (_nm_dbus_bus_type (),
+		           priv->init_data->cancellable,
+		           _init_start_bus_get_cb,
+		           self);
+		return;
+	}
+
+	priv->dbus_connection = dbus_connection;
+
+	_init_start_with_bus (self);
+
+	_notify (self, PROP_DBUS_CONNECTION);
+}
+
 static void
 _init_start (NMClient *self)
 {
@@ -7176,6 +7715,15 @@ _init_start (NMClient *self)
 	                    priv->init_data->is_sync ? "sync" : "async");
 
 	if (!priv->dbus_connection) {
+		if (_nm_dbus_use_private_socket ()) {
+			g_dbus_connection_new_for_address ("unix:path="NM_DBUS_PRIVATE_CLIENT_SOCKET,
+			                                   G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT,
+			                                   NULL,
+			                                   priv->init_data->cancellable,
+			                                   _init_start_private_connection_cb,
+			                                   self);
+			return;
+		}
 		g_bus_get (_nm_dbus_bus_type (),
 		           priv->init_data->cancellable,
 		           _init_start_bus_get_cb,
@@ -7199,6 +7747,9 @@ get_property (GObject *object, guint prop_id,
 	case PROP_INSTANCE_FLAGS:
 		g_value_set_uint (value, priv->instance_flags);
 		break;
+	case PROP_OBJECT_TYPES:
+		g_value_set_boxed (value, priv->object_types);
+		break;
 	case PROP_DBUS_CONNECTION:
 		g_value_set_object (value, priv->dbus_connection);
 		break;
@@ -7365,6 +7916,11 @@ set_property (GObject *object, guint prop_id,
 		priv->dbus_connection = g_value_dup_object (value);
 		break;
 
+	case PROP_OBJECT_TYPES:
+		/* construct-only */
+		priv->object_types = g_value_dup_boxed (value);
+		break;
+
 	case PROP_NETWORKING_ENABLED:
 		b = g_value_get_boolean (value);
 		if (priv->nm.networking_enabled != b) {
@@ -7634,6 +8190,36 @@ constructed (GObject *object)
 
 	priv->main_context = g_main_context_ref_thread_default ();
 
+	if (!NM_FLAGS_HAS (priv->instance_flags, NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS))
+		priv->lazy_loaded = LAZY_GROUP_ALL;
+
+	if (priv->object_types) {
+		guint i, n;
+
+		/* the types are registered on first use. Register all of them, so
+		 * that we can look them up by name. */
+		for (i = 0; i < G_N_ELEMENTS (_nml_dbus_meta_ifaces); i++) {
+			if (_nml_dbus_meta_ifaces[i]->get_type_fcn)
+				_nml_dbus_meta_ifaces[i]->get_type_fcn ();
+		}
+
+		priv->object_gtypes = g_new (GType, NM_PTRARRAY_LEN (priv->object_types) + 1);
+		for (i = 0, n = 0; priv->object_types[i]; i++) {
+			GType gtype;
+
+			gtype = g_type_from_name (priv->object_types[i]);
+			if (   !gtype
+			    || !g_type_is_a (gtype, NM_TYPE_OBJECT)) {
+				g_warning ("NMClient: \"%s\" in \"%s\" is not an NMObject type and is ignored",
+				           priv->object_types[i],
+				           NM_CLIENT_OBJECT_TYPES);
+				continue;
+			}
+			priv->object_gtypes[n++] = gtype;
+		}
+		priv->object_gtypes[n] = 0;
+	}
+
 	G_OBJECT_CLASS (nm_client_parent_class)->constructed (object);
 
 	NML_NMCLIENT_LOG_D (self, "new NMClient instance");
@@ -7649,11 +8235,17 @@ dispose (GObject *object)
 
 	self->obj_base.is_disposing = TRUE;
 
+	nm_clear_g_source_inst (&priv->lazy_idle_source);
+
 	nm_clear_g_cancellable (&priv->name_owner_get_cancellable);
 
 	nm_clear_g_dbus_connection_signal (priv->dbus_connection,
 	                                   &priv->name_owner_changed_id);
 
+	if (   priv->dbus_connection
+	    && priv->dbus_connection_is_peer)
+		g_signal_handlers_disconnect_by_func (priv->dbus_connection, _dbus_connection_closed_cb, self);
+
 	nm_clear_g_free (&priv->name_owner);
 
 	_init_release_all (self);
@@ -7698,6 +8290,9 @@ dispose (GObject *object)
 
 	nm_clear_g_free (&priv->permissions);
 
+	nm_clear_pointer (&priv->object_types, g_strfreev);
+	nm_clear_g_free (&priv->object_gtypes);
+
 	g_clear_object (&priv->dbus_connection);
 
 	g_clear_object (&priv->context_busy_watcher);
@@ -7809,6 +8404,8 @@ nm_client_class_init (NMClientClass *client_class)
 	 * This is a construct property and you may only set most flags only during
 	 * construction.
 	 *
+	 * The flag %NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS can only be set during construction.
+	 *
 	 * The flag %NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS can be toggled any time,
 	 * even after constructing the instance. Note that you may want to watch NMClient:permissions-state
 	 * property to know whether permissions are ready. Note that permissions are only fetched
@@ -7826,6 +8423,31 @@ nm_client_class_init (NMClientClass *client_class)
 	                       G_PARAM_CONSTRUCT |
 	                       G_PARAM_STATIC_STRINGS);
 
+	/**
+	 * NMClient:object-types:
+	 *
+	 * The names of the #NMObject types that the client tracks, for example
+	 * "NMDevice" and "NMActiveConnection". An object is tracked if its type
+	 * is one of these types or a subtype of them. For D-Bus objects of other
+	 * types, no #NMObject instances get created and their property changes
+	 * are ignored. In particular, if #NMRemoteConnection is not tracked,
+	 * the client does not fetch the settings of the connection profiles.
+	 * References to objects that are not tracked are %NULL. Names that
+	 * are not #NMObject types are ignored with a warning.
+	 *
+	 * If unset (the default), all objects are tracked. This is a
+	 * construct-only property.
+	 *
+	 * Since: 1.24
+	 */
+	obj_properties[PROP_OBJECT_TYPES] =
+	    g_param_spec_boxed (NM_CLIENT_OBJECT_TYPES, "", "",
+	                        G_TYPE_STRV,
+	                        G_PARAM_READABLE |
+	                        G_PARAM_WRITABLE |
+	                        G_PARAM_CONSTRUCT_ONLY |
+	                        G_PARAM_STATIC_STRINGS);
+
 	/**
 	 * NMClient:dbus-name-owner:
 	 *
@@ -24,12 +24,32 @@ G_BEGIN_DECLS
  *   can be disabled. You can toggle this flag to enable and disable automatic
  *   fetching of the permissions. Watch also nm_client_get_permissions_state()
  *   to know whether the permissions are up to date.
+ * @NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS: only create the #NMObject instances
+ *   when they are needed. The lists of devices, active connections and
+ *   checkpoints get populated when they are accessed the first time (for
+ *   example via nm_client_get_devices()). Until then, the corresponding
+ *   signals like #NMClient::device-added are not emitted. Objects that are
+ *   not referenced by anything are only created when looked up by path.
+ *   When such a getter is called from a signal handler or property
+ *   notification of NMClient, the objects cannot be created right away.
+ *   Then the getter may return incomplete results (for example an empty
+ *   list or %NULL), and the objects get created on the next main loop
+ *   iteration, followed by the corresponding signals.
+ *   This flag can only be set during construction.
+ * @NM_CLIENT_INSTANCE_FLAGS_SUBSCRIBE_INTERFACES: subscribe to the
+ *   PropertiesChanged signals of high-volume interfaces, like access
+ *   points and IP configurations, that NetworkManager only sends to
+ *   subscribed clients if "filter-dbus-signals" is enabled. A client
+ *   that sets #NMClient:object-types subscribes to the tracked interfaces
+ *   also without this flag. This flag can only be set during construction.
  *
  * Since: 1.24
  */
 typedef enum { /*< flags >*/
 	NM_CLIENT_INSTANCE_FLAGS_NONE                      = 0,
 	NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS = 1,
+	NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS              = 2,
+	NM_CLIENT_INSTANCE_FLAGS_SUBSCRIBE_INTERFACES      = 4,
 } NMClientInstanceFlags;
 
 #define NM_TYPE_CLIENT            (nm_client_get_type ())
@@ -46,6 +66,7 @@ typedef enum { /*< flags >*/
 #define NM_CLIENT_DBUS_CONNECTION "dbus-connection"
 #define NM_CLIENT_DBUS_NAME_OWNER "dbus-name-owner"
 #define NM_CLIENT_INSTANCE_FLAGS  "instance-flags"
+#define NM_CLIENT_OBJECT_TYPES    "object-types"
 
 _NM_DEPRECATED_SYNC_WRITABLE_PROPERTY
 #define NM_CLIENT_NETWORKING_ENABLED "networking-enabled"
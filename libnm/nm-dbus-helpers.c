@@ -7,6 +7,8 @@
 
 #include "nm-dbus-helpers.h"
 
+#include <unistd.h>
+
 #include "nm-dbus-interface.h"
 
 GBusType
@@ -27,6 +29,25 @@ _nm_dbus_bus_type (void)
 	return v;
 }
 
+/* Whether NMClient should talk to NetworkManager on its private socket
+ * instead of the system bus. That is only possible for root. */
+gboolean
+_nm_dbus_use_private_socket (void)
+{
+	static int use_private_socket = -1;
+	int v;
+
+	v = g_atomic_int_get (&use_private_socket);
+	if (G_UNLIKELY (v == -1)) {
+		v =    _nm_utils_ascii_str_to_bool (g_getenv ("LIBNM_USE_PRIVATE_SOCKET"), FALSE) == TRUE
+		    && !g_getenv ("LIBNM_USE_SESSION_BUS")
+		    && geteuid () == 0;
+		if (!g_atomic_int_compare_and_exchange (&use_private_socket, -1, v))
+			v = g_atomic_int_get (&use_private_socket);
+	}
+	return v;
+}
+
 /* Binds the properties on a generated server-side GDBus object to the
  * corresponding properties on the public object.
  */
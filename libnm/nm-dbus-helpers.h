@@ -16,6 +16,8 @@
 
 GBusType _nm_dbus_bus_type (void);
 
+gboolean _nm_dbus_use_private_socket (void);
+
 void _nm_dbus_bind_properties (gpointer object,
                                gpointer skeleton);
 
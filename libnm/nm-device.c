@@ -60,6 +60,7 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMDevice,
 	PROP_IP4_CONNECTIVITY,
 	PROP_IP6_CONNECTIVITY,
 	PROP_INTERFACE_FLAGS,
+	PROP_ACTIVATION_TIMELINE,
 );
 
 enum {
@@ -83,6 +84,7 @@ typedef struct _NMDevicePrivate {
 	NMLDBusPropertyO property_o[_PROPERTY_O_IDX_NUM];
 	NMLDBusPropertyAO available_connections;
 	GPtrArray *lldp_neighbors;
+	GVariant *activation_timeline;
 	char *driver;
 	char *driver_version;
 	char *interface;
@@ -259,6 +261,32 @@ _notify_update_prop_lldp_neighbors (NMClient *client,
 	return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
 }
 
+static NMLDBusNotifyUpdatePropFlags
+_notify_update_prop_activation_timeline (NMClient *client,
+                                         NMLDBusObject *dbobj,
+                                         const NMLDBusMetaIface *meta_iface,
+                                         guint dbus_property_idx,
+                                         GVariant *value)
+{
+	NMDevice *self = NM_DEVICE (dbobj->nmobj);
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+
+	if (   value
+	    && g_variant_n_children (value) == 0)
+		value = NULL;
+
+	if (   priv->activation_timeline == value
+	    || (   priv->activation_timeline
+	        && value
+	        && g_variant_equal (priv->activation_timeline, value)))
+		return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NONE;
+
+	nm_clear_pointer (&priv->activation_timeline, g_variant_unref);
+	if (value)
+		priv->activation_timeline = g_variant_ref (value);
+	return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
+}
+
 /*****************************************************************************/
 
 static NMDeviceType
@@ -326,6 +354,7 @@ finalize (GObject *object)
 	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (object);
 
 	g_clear_pointer (&priv->lldp_neighbors, g_ptr_array_unref);
+	nm_clear_pointer (&priv->activation_timeline, g_variant_unref);
 
 	g_free (priv->interface);
 	g_free (priv->ip_interface);
@@ -445,6 +474,9 @@ get_property (GObject *object,
 	case PROP_INTERFACE_FLAGS:
 		g_value_set_uint (value, nm_device_get_interface_flags (device));
 		break;
+	case PROP_ACTIVATION_TIMELINE:
+		g_value_set_variant (value, nm_device_get_activation_timeline (device));
+		break;
 	default:
 		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 		break;
@@ -490,6 +522,7 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_device = NML_DBUS_META_IFACE_INIT
 	nm_device_get_type,
 	NML_DBUS_META_INTERFACE_PRIO_PARENT_TYPE,
 	NML_DBUS_META_IFACE_DBUS_PROPERTIES (
+		NML_DBUS_META_PROPERTY_INIT_FCN     ("ActivationTimeline",   PROP_ACTIVATION_TIMELINE,   "a(su)",         _notify_update_prop_activation_timeline                                                              ),
 		NML_DBUS_META_PROPERTY_INIT_O_PROP  ("ActiveConnection",     PROP_ACTIVE_CONNECTION,     NMDevicePrivate, property_o[PROPERTY_O_IDX_ACTIVE_CONNECTION], nm_active_connection_get_type, .is_always_ready = TRUE ),
 		NML_DBUS_META_PROPERTY_INIT_B       ("Autoconnect",          PROP_AUTOCONNECT,           NMDevicePrivate, autoconnect                                                                                          ),
 		NML_DBUS_META_PROPERTY_INIT_AO_PROP ("AvailableConnections", PROP_AVAILABLE_CONNECTIONS, NMDevicePrivate, available_connections,                        nm_remote_connection_get_type, .is_always_ready = TRUE ),
@@ -903,6 +936,21 @@ nm_device_class_init (NMDeviceClass *klass)
 	                       G_PARAM_READABLE |
 	                       G_PARAM_STATIC_STRINGS);
 
+	/**
+	 * NMDevice:activation-timeline:
+	 *
+	 * The timeline of the current or last activation, as a #GVariant
+	 * of type "a(su)". See nm_device_get_activation_timeline().
+	 *
+	 * Since: 1.24
+	 **/
+	obj_properties[PROP_ACTIVATION_TIMELINE] =
+	    g_param_spec_variant (NM_DEVICE_ACTIVATION_TIMELINE, "", "",
+	                          G_VARIANT_TYPE ("a(su)"),
+	                          NULL,
+	                          G_PARAM_READABLE |
+	                          G_PARAM_STATIC_STRINGS);
+
 	_nml_dbus_meta_class_init_with_properties (object_class, &_nml_dbus_meta_iface_nm_device);
 
 	/**
@@ -2001,6 +2049,28 @@ nm_device_get_metered (NMDevice *device)
 
 NM_BACKPORT_SYMBOL (libnm_1_0_6, NMMetered, nm_device_get_metered, (NMDevice *device), (device));
 
+/**
+ * nm_device_get_activation_timeline:
+ * @device: a #NMDevice
+ *
+ * Gets the timeline of the current or the last activation of the device.
+ * Each element is a pair of an event name (like "prepare", "dhcp4-lease"
+ * or "activated") and the time in milliseconds at which it happened,
+ * relative to the start of the activation.
+ *
+ * Returns: (transfer none) (nullable): a #GVariant of type "a(su)",
+ * or %NULL if the device has no timeline.
+ *
+ * Since: 1.24
+ **/
+GVariant *
+nm_device_get_activation_timeline (NMDevice *device)
+{
+	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
+
+	return NM_DEVICE_GET_PRIVATE (device)->activation_timeline;
+}
+
 /**
  * nm_device_get_lldp_neighbors:
  * @device: a #NMDevice
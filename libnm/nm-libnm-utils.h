@@ -233,7 +233,7 @@ typedef enum {
 
 /*****************************************************************************/
 
-#define NM_CLIENT_INSTANCE_FLAGS_ALL ((NMClientInstanceFlags) 0x1)
+#define NM_CLIENT_INSTANCE_FLAGS_ALL ((NMClientInstanceFlags) 0x7)
 
 typedef struct {
 	GType (*get_o_type_fcn) (void);
@@ -663,6 +663,14 @@ struct _NMLDBusObject {
 	NMLDBusObjState obj_state:4;
 
 	NMLDBusObjChangedType obj_changed_type:3;
+
+	/* With NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS, the NMObject was explicitly
+	 * requested, even if nothing references it. */
+	bool nmobj_wanted:1;
+
+	/* The type of the object is not in NMClient:object-types. We never
+	 * create an NMObject for it. */
+	bool nmobj_untracked:1;
 };
 
 static inline gboolean
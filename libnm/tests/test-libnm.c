@@ -2821,6 +2821,7 @@ check_dbus_properties:
 				{ "aa{sv}",    G_TYPE_PTR_ARRAY },
 
 				{ "(uu)",      G_TYPE_NONE },
+				{ "a(su)",     G_TYPE_NONE },
 				{ "aau",       G_TYPE_NONE },
 				{ "au",        G_TYPE_NONE },
 				{ "a(ayuay)",  G_TYPE_NONE },
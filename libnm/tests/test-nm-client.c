@@ -1301,6 +1301,187 @@ test_connection_invalid (void)
 
 /*****************************************************************************/
 
+static void
+test_lazy_objects (void)
+{
+	nmtstc_auto_service_cleanup NMTstcServiceInfo *sinfo = NULL;
+	gs_unref_object NMClient *client = NULL;
+	gs_unref_object NMClient *client_lazy = NULL;
+	const GPtrArray *devices;
+	NMDevice *device;
+	const char *path;
+
+	sinfo = nmtstc_service_init ();
+	if (!nmtstc_service_available (sinfo))
+		return;
+
+	client = nmtstc_client_new (TRUE);
+
+	device = nmtstc_service_add_device (sinfo, client, "AddWiredDevice", "eth0");
+	path = nm_object_get_path (NM_OBJECT (device));
+
+	client_lazy = nmtstc_context_object_new (NM_TYPE_CLIENT,
+	                                         TRUE,
+	                                         NM_CLIENT_INSTANCE_FLAGS, (guint) NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS,
+	                                         NULL);
+	g_assert (NM_FLAGS_HAS (nm_client_get_instance_flags (client_lazy), NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS));
+
+	devices = nm_client_get_devices (client_lazy);
+	g_assert_cmpint (devices->len, ==, 1);
+	g_assert (NM_IS_DEVICE_ETHERNET (devices->pdata[0]));
+	g_assert_cmpstr (nm_object_get_path (devices->pdata[0]), ==, path);
+	g_assert_cmpstr (nm_device_get_iface (devices->pdata[0]), ==, "eth0");
+
+	g_assert (nm_client_get_device_by_path (client_lazy, path) == devices->pdata[0]);
+	g_assert (nm_client_get_device_by_iface (client_lazy, "eth0") == devices->pdata[0]);
+	g_assert_cmpint (nm_client_get_all_devices (client_lazy)->len, ==, 1);
+}
+
+static void
+test_object_types (void)
+{
+	nmtstc_auto_service_cleanup NMTstcServiceInfo *sinfo = NULL;
+	gs_unref_object NMClient *client = NULL;
+	gs_unref_object NMClient *client_filtered = NULL;
+	gs_unref_object NMClient *client_invalid = NULL;
+	gs_unref_object NMConnection *connection = NULL;
+	const char *const object_types[] = { "NMDevice", NULL };
+	const char *const object_types_invalid[] = { "NMNoSuchType", "NMClient", "NMDevice", NULL };
+	const GPtrArray *devices;
+
+	sinfo = nmtstc_service_init ();
+	if (!nmtstc_service_available (sinfo))
+		return;
+
+	client = nmtstc_client_new (TRUE);
+
+	nmtstc_service_add_device (sinfo, client, "AddWiredDevice", "eth0");
+
+	connection = nmtst_create_minimal_connection ("test-object-types", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+	nmtstc_service_add_connection (sinfo, connection, TRUE, NULL);
+
+	client_filtered = nmtstc_context_object_new (NM_TYPE_CLIENT,
+	                                             TRUE,
+	                                             NM_CLIENT_OBJECT_TYPES, object_types,
+	                                             NULL);
+
+	devices = nm_client_get_devices (client_filtered);
+	g_assert_cmpint (devices->len, ==, 1);
+	g_assert (NM_IS_DEVICE_ETHERNET (devices->pdata[0]));
+	g_assert_cmpint (nm_client_get_connections (client_filtered)->len, ==, 0);
+
+	/* names that are not NMObject types are ignored with a warning. */
+	NMTST_EXPECT_LIBNM_WARNING ("*\"NMNoSuchType\"*");
+	NMTST_EXPECT_LIBNM_WARNING ("*\"NMClient\"*");
+	client_invalid = nmtstc_context_object_new (NM_TYPE_CLIENT,
+	                                            TRUE,
+	                                            NM_CLIENT_OBJECT_TYPES, object_types_invalid,
+	                                            NULL);
+	g_test_assert_expected_messages ();
+	g_assert_cmpint (nm_client_get_devices (client_invalid)->len, ==, 1);
+	g_assert_cmpint (nm_client_get_connections (client_invalid)->len, ==, 0);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	const char *path;
+	int depth;
+	guint n_device_added;
+	guint n_notify;
+} LazyReentrantData;
+
+static void
+_lazy_reentrant_call_getters (NMClient *client,
+                              LazyReentrantData *data)
+{
+	const GPtrArray *devices;
+
+	/* none of these may emit signals while we are in a signal handler. */
+	devices = nm_client_get_devices (client);
+	g_assert (devices);
+	g_assert (devices->len <= 1);
+	g_assert (nm_client_get_all_devices (client));
+	g_assert (nm_client_get_active_connections (client));
+	g_assert (nm_client_get_checkpoints (client));
+	nm_client_get_primary_connection (client);
+	nm_client_get_activating_connection (client);
+	nm_client_get_device_by_path (client, data->path);
+}
+
+static void
+_lazy_reentrant_device_added_cb (NMClient *client,
+                                 NMDevice *device,
+                                 LazyReentrantData *data)
+{
+	g_assert_cmpint (data->depth, ==, 0);
+	data->depth++;
+	data->n_device_added++;
+	g_assert_cmpstr (nm_object_get_path (NM_OBJECT (device)), ==, data->path);
+	_lazy_reentrant_call_getters (client, data);
+	data->depth--;
+}
+
+static void
+_lazy_reentrant_notify_cb (NMClient *client,
+                           GParamSpec *pspec,
+                           LazyReentrantData *data)
+{
+	g_assert_cmpint (data->depth, ==, 0);
+	data->depth++;
+	data->n_notify++;
+	_lazy_reentrant_call_getters (client, data);
+	data->depth--;
+}
+
+static void
+test_lazy_objects_reentrant (void)
+{
+	nmtstc_auto_service_cleanup NMTstcServiceInfo *sinfo = NULL;
+	gs_unref_object NMClient *client = NULL;
+	gs_unref_object NMClient *client_lazy = NULL;
+	LazyReentrantData data = { };
+	const GPtrArray *devices;
+	NMDevice *device;
+
+	sinfo = nmtstc_service_init ();
+	if (!nmtstc_service_available (sinfo))
+		return;
+
+	client = nmtstc_client_new (TRUE);
+
+	device = nmtstc_service_add_device (sinfo, client, "AddWiredDevice", "eth0");
+	data.path = nm_object_get_path (NM_OBJECT (device));
+
+	client_lazy = nmtstc_context_object_new (NM_TYPE_CLIENT,
+	                                         TRUE,
+	                                         NM_CLIENT_INSTANCE_FLAGS, (guint) NM_CLIENT_INSTANCE_FLAGS_LAZY_OBJECTS,
+	                                         NULL);
+
+	g_signal_connect (client_lazy, NM_CLIENT_DEVICE_ADDED, G_CALLBACK (_lazy_reentrant_device_added_cb), &data);
+	g_signal_connect (client_lazy, "notify", G_CALLBACK (_lazy_reentrant_notify_cb), &data);
+
+	/* loading the devices emits "device-added", whose handler calls
+	 * the getters of the other lazy properties. */
+	devices = nm_client_get_devices (client_lazy);
+	g_assert_cmpint (data.depth, ==, 0);
+	g_assert_cmpint (data.n_device_added, ==, 1);
+	g_assert_cmpint (devices->len, ==, 1);
+	g_assert_cmpstr (nm_object_get_path (devices->pdata[0]), ==, data.path);
+
+	/* the deferred loading happens on idle. */
+	nmtst_main_context_iterate_until (NULL, 100, FALSE);
+	g_assert_cmpint (data.depth, ==, 0);
+	g_assert_cmpint (data.n_device_added, ==, 1);
+	g_assert_cmpint (nm_client_get_devices (client_lazy)->len, ==, 1);
+	g_assert_cmpint (nm_client_get_active_connections (client_lazy)->len, ==, 0);
+	g_assert_cmpint (nm_client_get_checkpoints (client_lazy)->len, ==, 0);
+
+	g_signal_handlers_disconnect_by_data (client_lazy, &data);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -1321,6 +1502,9 @@ main (int argc, char **argv)
 	g_test_add_func ("/libnm/activate-virtual", test_activate_virtual);
 	g_test_add_func ("/libnm/device-connection-compatibility", test_device_connection_compatibility);
 	g_test_add_func ("/libnm/connection/invalid", test_connection_invalid);
+	g_test_add_func ("/libnm/lazy-objects", test_lazy_objects);
+	g_test_add_func ("/libnm/lazy-objects/reentrant", test_lazy_objects_reentrant);
+	g_test_add_func ("/libnm/object-types", test_object_types);
 
 	return g_test_run ();
 }
@@ -468,6 +468,138 @@ test_save_hostname (void)
 
 /*****************************************************************************/
 
+static void
+add_connections_new_connection_cb (GDBusConnection *connection,
+                                   const char *sender_name,
+                                   const char *object_path,
+                                   const char *interface_name,
+                                   const char *signal_name,
+                                   GVariant *parameters,
+                                   gpointer user_data)
+{
+	GPtrArray *paths = user_data;
+	const char *path;
+
+	g_variant_get (parameters, "(&o)", &path);
+	g_ptr_array_add (paths, g_strdup (path));
+}
+
+static void
+add_connections_added_cb (NMClient *client,
+                          NMRemoteConnection *connection,
+                          GPtrArray *paths)
+{
+	g_ptr_array_add (paths, g_strdup (nm_object_get_path (NM_OBJECT (connection))));
+}
+
+static void
+test_add_connections (void)
+{
+	gs_unref_object NMConnection *con_a = NULL;
+	gs_unref_object NMConnection *con_b = NULL;
+	gs_unref_object NMConnection *con_bad = NULL;
+	gs_unref_ptrarray GPtrArray *new_connection_paths = NULL;
+	gs_unref_ptrarray GPtrArray *added_paths = NULL;
+	gs_unref_variant GVariant *ret = NULL;
+	gs_unref_variant GVariant *results = NULL;
+	GVariantBuilder builder;
+	GError *error = NULL;
+	char *paths[4] = { };
+	guint signal_id;
+	gulong handler_id;
+	guint i;
+
+	if (!nmtstc_service_available (gl.sinfo))
+		return;
+
+	con_a = nmtst_create_minimal_connection ("batch-a", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+	con_b = nmtst_create_minimal_connection ("batch-b", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+
+	/* The test daemon doesn't support bond connections */
+	con_bad = nmtst_create_minimal_connection ("batch-bad", NULL, NM_SETTING_BOND_SETTING_NAME, NULL);
+
+	/* the second item duplicates the UUID of the first one and fails, as does
+	 * the bond. The others must still be added, in the order of the request. */
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sa{sv}}"));
+	g_variant_builder_add_value (&builder, nm_connection_to_dbus (con_a, NM_CONNECTION_SERIALIZE_ALL));
+	g_variant_builder_add_value (&builder, nm_connection_to_dbus (con_a, NM_CONNECTION_SERIALIZE_ALL));
+	g_variant_builder_add_value (&builder, nm_connection_to_dbus (con_bad, NM_CONNECTION_SERIALIZE_ALL));
+	g_variant_builder_add_value (&builder, nm_connection_to_dbus (con_b, NM_CONNECTION_SERIALIZE_ALL));
+
+	new_connection_paths = g_ptr_array_new_with_free_func (g_free);
+	added_paths = g_ptr_array_new_with_free_func (g_free);
+
+	signal_id = g_dbus_connection_signal_subscribe (gl.bus,
+	                                                NM_DBUS_SERVICE,
+	                                                NM_DBUS_INTERFACE_SETTINGS,
+	                                                "NewConnection",
+	                                                NM_DBUS_PATH_SETTINGS,
+	                                                NULL,
+	                                                G_DBUS_SIGNAL_FLAGS_NONE,
+	                                                add_connections_new_connection_cb,
+	                                                new_connection_paths,
+	                                                NULL);
+	handler_id = g_signal_connect (gl.client,
+	                               NM_CLIENT_CONNECTION_ADDED,
+	                               G_CALLBACK (add_connections_added_cb),
+	                               added_paths);
+
+	ret = g_dbus_connection_call_sync (gl.bus,
+	                                   NM_DBUS_SERVICE,
+	                                   NM_DBUS_PATH_SETTINGS,
+	                                   NM_DBUS_INTERFACE_SETTINGS,
+	                                   "AddConnections",
+	                                   g_variant_new ("(aa{sa{sv}}u@a{sv})",
+	                                                  &builder,
+	                                                  (guint32) NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY,
+	                                                  g_variant_new_array (G_VARIANT_TYPE ("{sv}"), NULL, 0)),
+	                                   G_VARIANT_TYPE ("(aa{sv})"),
+	                                   G_DBUS_CALL_FLAGS_NONE,
+	                                   5000,
+	                                   NULL,
+	                                   &error);
+	nmtst_assert_success (ret, error);
+
+	results = g_variant_get_child_value (ret, 0);
+	g_assert_cmpint (g_variant_n_children (results), ==, 4);
+	for (i = 0; i < 4; i++) {
+		gs_unref_variant GVariant *result = g_variant_get_child_value (results, i);
+		const char *str;
+
+		if (g_variant_lookup (result, "path", "o", &paths[i]))
+			g_assert (!g_variant_lookup (result, "error", "&s", &str));
+		else
+			g_assert (g_variant_lookup (result, "error", "&s", &str));
+	}
+	g_assert (paths[0]);
+	g_assert (!paths[1]);
+	g_assert (!paths[2]);
+	g_assert (paths[3]);
+
+	nmtst_main_context_iterate_until_assert (NULL, 5000,    new_connection_paths->len >= 2
+	                                                     && added_paths->len >= 2);
+
+	/* NewConnection is emitted for the added profiles in the order of the
+	 * request, and NMClient announces them in that order too. */
+	g_assert_cmpint (new_connection_paths->len, ==, 2);
+	g_assert_cmpstr (new_connection_paths->pdata[0], ==, paths[0]);
+	g_assert_cmpstr (new_connection_paths->pdata[1], ==, paths[3]);
+	g_assert_cmpint (added_paths->len, ==, 2);
+	g_assert_cmpstr (added_paths->pdata[0], ==, paths[0]);
+	g_assert_cmpstr (added_paths->pdata[1], ==, paths[3]);
+
+	g_assert (nm_client_get_connection_by_path (gl.client, paths[0]));
+	g_assert (nm_client_get_connection_by_path (gl.client, paths[3]));
+
+	g_signal_handler_disconnect (gl.client, handler_id);
+	g_dbus_connection_signal_unsubscribe (gl.bus, signal_id);
+
+	for (i = 0; i < 4; i++)
+		g_free (paths[i]);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -497,6 +629,7 @@ main (int argc, char **argv)
 	g_test_add_func ("/client/add_remove_connection", test_add_remove_connection);
 	g_test_add_func ("/client/add_bad_connection", test_add_bad_connection);
 	g_test_add_func ("/client/save_hostname", test_save_hostname);
+	g_test_add_func ("/client/add_connections", test_add_connections);
 
 	ret = g_test_run ();
 
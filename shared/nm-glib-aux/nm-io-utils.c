@@ -328,12 +328,13 @@ nm_utils_file_get_contents (int dirfd,
  * specifying a mode for the new file.
  */
 gboolean
-nm_utils_file_set_contents (const char *filename,
-                            const char *contents,
-                            gssize length,
-                            mode_t mode,
-                            int *out_errsv,
-                            GError **error)
+nm_utils_file_set_contents_full (const char *filename,
+                                 const char *contents,
+                                 gssize length,
+                                 mode_t mode,
+                                 NMUtilsFileSetContentsFlags flags,
+                                 int *out_errsv,
+                                 GError **error)
 {
 	gs_free char *tmp_name = NULL;
 	struct stat statbuf;
@@ -386,7 +387,8 @@ nm_utils_file_set_contents (const char *filename,
 	 * the new and the old file on some filesystems. (I.E. those that don't
 	 * guarantee the data is written to the disk before the metadata.)
 	 */
-	if (   lstat (filename, &statbuf) == 0
+	if (   !NM_FLAGS_HAS (flags, NM_UTILS_FILE_SET_CONTENTS_FLAG_NO_FSYNC)
+	    && lstat (filename, &statbuf) == 0
 	    && statbuf.st_size > 0) {
 		if (fsync (fd) != 0) {
 			errsv = NM_ERRNO_NATIVE (errno);
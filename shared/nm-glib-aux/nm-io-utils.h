@@ -40,12 +40,38 @@ gboolean nm_utils_file_get_contents (int dirfd,
                                      int *out_errsv,
                                      GError **error);
 
-gboolean nm_utils_file_set_contents (const char *filename,
-                                     const char *contents,
-                                     gssize length,
-                                     mode_t mode,
-                                     int *out_errsv,
-                                     GError **error);
+typedef enum {
+	NM_UTILS_FILE_SET_CONTENTS_FLAG_NONE     = 0,
+
+	/* don't fsync() the new file before renaming it. The caller
+	 * takes care to sync the file system later. */
+	NM_UTILS_FILE_SET_CONTENTS_FLAG_NO_FSYNC = (1 << 0),
+} NMUtilsFileSetContentsFlags;
+
+gboolean nm_utils_file_set_contents_full (const char *filename,
+                                          const char *contents,
+                                          gssize length,
+                                          mode_t mode,
+                                          NMUtilsFileSetContentsFlags flags,
+                                          int *out_errsv,
+                                          GError **error);
+
+static inline gboolean
+nm_utils_file_set_contents (const char *filename,
+                            const char *contents,
+                            gssize length,
+                            mode_t mode,
+                            int *out_errsv,
+                            GError **error)
+{
+	return nm_utils_file_set_contents_full (filename,
+	                                        contents,
+	                                        length,
+	                                        mode,
+	                                        NM_UTILS_FILE_SET_CONTENTS_FLAG_NONE,
+	                                        out_errsv,
+	                                        error);
+}
 
 ssize_t nm_utils_fd_read (int fd, GString *out_string);
 
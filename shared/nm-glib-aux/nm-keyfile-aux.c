@@ -222,6 +222,16 @@ nm_key_file_db_is_dirty (NMKeyFileDB *self)
 	return self->dirty;
 }
 
+/* Forget about pending changes without writing the file. Use this if the
+ * caller persisted the changes by other means. */
+void
+nm_key_file_db_clear_dirty (NMKeyFileDB *self)
+{
+	g_return_if_fail (_IS_KEY_FILE_DB (self, FALSE, TRUE));
+
+	self->dirty = FALSE;
+}
+
 /*****************************************************************************/
 
 char *
@@ -36,6 +36,8 @@ const char *nm_key_file_db_get_filename (NMKeyFileDB *self);
 
 gboolean nm_key_file_db_is_dirty (NMKeyFileDB *self);
 
+void nm_key_file_db_clear_dirty (NMKeyFileDB *self);
+
 char *nm_key_file_db_get_value (NMKeyFileDB *self,
                                 const char *key);
 
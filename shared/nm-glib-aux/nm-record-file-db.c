@@ -0,0 +1,424 @@
+// SPDX-License-Identifier: LGPL-2.1+
+/*
+ * Copyright (C) 2020 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "nm-record-file-db.h"
+
+#include <syslog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+/*****************************************************************************/
+
+/* The file starts with a FileHeader, followed by n_records FileRecords.
+ * A record with an empty key is unused. All integers are in host byte order,
+ * the file is not intended to be shared between machines. */
+
+#define FILE_MAGIC "NMRDB\0\0\1"
+
+#define N_RECORDS_INITIAL 64
+
+typedef struct {
+	char magic[8];
+	guint32 record_size;
+	guint32 n_records;
+} FileHeader;
+
+typedef struct {
+	char key[NM_RECORD_FILE_DB_KEY_MAX_LEN + 1];
+	guint64 value;
+} FileRecord;
+
+G_STATIC_ASSERT (sizeof (FileHeader) == 16);
+G_STATIC_ASSERT (sizeof (FileRecord) % 8 == 0);
+G_STATIC_ASSERT (NM_STRLEN (FILE_MAGIC) == sizeof (((FileHeader *) NULL)->magic));
+
+struct _NMRecordFileDB {
+	NMRecordFileDBLogFcn log_fcn;
+	gpointer user_data;
+
+	/* maps the key (a copy) to the index of the record plus one. */
+	GHashTable *idx;
+
+	guint8 *map;
+	gsize map_len;
+
+	guint n_records;
+
+	/* no record before this index is unused. */
+	guint free_hint;
+
+	int fd;
+
+	bool is_started:1;
+
+	char filename[];
+};
+
+#define _NMLOG(self, \
+               syslog_level, \
+               fmt, \
+               ...) \
+	G_STMT_START { \
+		NMRecordFileDB *_self = (self); \
+		\
+		nm_assert (_self); \
+		\
+		if (_self->log_fcn) { \
+			_self->log_fcn (_self, \
+			                (syslog_level), \
+			                _self->user_data, \
+			                ""fmt"", \
+			                ##__VA_ARGS__); \
+		}; \
+	} G_STMT_END
+
+#define _LOGD(...) _NMLOG (self, LOG_DEBUG, __VA_ARGS__)
+
+/*****************************************************************************/
+
+static FileHeader *
+_header (NMRecordFileDB *self)
+{
+	nm_assert (self->map);
+
+	return (FileHeader *) self->map;
+}
+
+static FileRecord *
+_record (NMRecordFileDB *self, guint i)
+{
+	nm_assert (self->map);
+	nm_assert (i < self->n_records);
+
+	return &((FileRecord *) &self->map[sizeof (FileHeader)])[i];
+}
+
+static void
+_unmap (NMRecordFileDB *self)
+{
+	if (self->map) {
+		munmap (self->map, self->map_len);
+		self->map = NULL;
+		self->map_len = 0;
+		self->n_records = 0;
+	}
+}
+
+static gboolean
+_map (NMRecordFileDB *self, guint n_records, gboolean init_header)
+{
+	gsize map_len;
+	gpointer map;
+	int errsv;
+
+	nm_assert (self->fd >= 0);
+	nm_assert (n_records > 0);
+
+	_unmap (self);
+
+	map_len = sizeof (FileHeader) + ((gsize) n_records) * sizeof (FileRecord);
+
+	if (init_header) {
+		if (ftruncate (self->fd, map_len) != 0) {
+			errsv = errno;
+			_LOGD ("failure to resize \"%s\": %s", self->filename, nm_strerror_native (errsv));
+			return FALSE;
+		}
+	}
+
+	map = mmap (NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+	if (map == MAP_FAILED) {
+		errsv = errno;
+		_LOGD ("failure to map \"%s\": %s", self->filename, nm_strerror_native (errsv));
+		return FALSE;
+	}
+
+	self->map = map;
+	self->map_len = map_len;
+	self->n_records = n_records;
+
+	if (init_header) {
+		memcpy (_header (self)->magic, FILE_MAGIC, sizeof (_header (self)->magic));
+		_header (self)->record_size = sizeof (FileRecord);
+		_header (self)->n_records = n_records;
+	}
+
+	return TRUE;
+}
+
+/*****************************************************************************/
+
+NMRecordFileDB *
+nm_record_file_db_new (const char *filename,
+                       NMRecordFileDBLogFcn log_fcn,
+                       gpointer user_data)
+{
+	NMRecordFileDB *self;
+	gsize l_filename;
+
+	g_return_val_if_fail (filename && filename[0], NULL);
+
+	l_filename = strlen (filename);
+
+	self = g_malloc0 (sizeof (NMRecordFileDB) + l_filename + 1);
+	self->log_fcn = log_fcn;
+	self->user_data = user_data;
+	self->fd = -1;
+	self->idx = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	memcpy (self->filename, filename, l_filename + 1);
+
+	return self;
+}
+
+void
+nm_record_file_db_destroy (NMRecordFileDB *self)
+{
+	if (!self)
+		return;
+
+	_unmap (self);
+	if (self->fd >= 0)
+		nm_close (self->fd);
+	g_hash_table_unref (self->idx);
+	g_free (self);
+}
+
+/*****************************************************************************/
+
+/* nm_record_file_db_start() opens (or creates) the file. If the file
+ * cannot be used, the database stays empty and all updates are ignored. */
+gboolean
+nm_record_file_db_start (NMRecordFileDB *self)
+{
+	struct stat st;
+	guint n_records = 0;
+	gboolean valid = FALSE;
+	guint n_used = 0;
+	guint i;
+	int errsv;
+
+	g_return_val_if_fail (self, FALSE);
+	g_return_val_if_fail (!self->is_started, FALSE);
+
+	self->is_started = TRUE;
+
+	self->fd = open (self->filename, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (self->fd < 0) {
+		errsv = errno;
+		_LOGD ("failure to open \"%s\": %s", self->filename, nm_strerror_native (errsv));
+		return FALSE;
+	}
+
+	if (fstat (self->fd, &st) != 0) {
+		errsv = errno;
+		_LOGD ("failure to stat \"%s\": %s", self->filename, nm_strerror_native (errsv));
+		goto fail;
+	}
+
+	if (   st.st_size > (off_t) sizeof (FileHeader)
+	    && st.st_size < (off_t) G_MAXINT32) {
+		FileHeader header;
+
+		if (   pread (self->fd, &header, sizeof (header), 0) == sizeof (header)
+		    && memcmp (header.magic, FILE_MAGIC, sizeof (header.magic)) == 0
+		    && header.record_size == sizeof (FileRecord)
+		    && header.n_records > 0
+		    && st.st_size == (off_t) (sizeof (FileHeader) + ((gsize) header.n_records) * sizeof (FileRecord))) {
+			n_records = header.n_records;
+			valid = TRUE;
+		}
+	}
+
+	if (!valid) {
+		if (st.st_size > 0)
+			_LOGD ("reset invalid file \"%s\"", self->filename);
+		if (   ftruncate (self->fd, 0) != 0
+		    || !_map (self, N_RECORDS_INITIAL, TRUE))
+			goto fail;
+		return TRUE;
+	}
+
+	if (!_map (self, n_records, FALSE))
+		goto fail;
+
+	for (i = 0; i < self->n_records; i++) {
+		FileRecord *r = _record (self, i);
+
+		if (r->key[0] == '\0')
+			continue;
+
+		if (   r->key[NM_RECORD_FILE_DB_KEY_MAX_LEN] != '\0'
+		    || g_hash_table_contains (self->idx, r->key)) {
+			/* drop invalid or duplicate records. */
+			memset (r, 0, sizeof (*r));
+			continue;
+		}
+
+		g_hash_table_insert (self->idx, g_strdup (r->key), GUINT_TO_POINTER (i + 1));
+		n_used++;
+	}
+
+	_LOGD ("loaded %u records from \"%s\"", n_used, self->filename);
+	return TRUE;
+
+fail:
+	_unmap (self);
+	nm_close (self->fd);
+	self->fd = -1;
+	return FALSE;
+}
+
+/*****************************************************************************/
+
+const char *
+nm_record_file_db_get_filename (NMRecordFileDB *self)
+{
+	g_return_val_if_fail (self, NULL);
+
+	return self->filename;
+}
+
+guint
+nm_record_file_db_get_length (NMRecordFileDB *self)
+{
+	g_return_val_if_fail (self, 0);
+
+	return g_hash_table_size (self->idx);
+}
+
+gboolean
+nm_record_file_db_get (NMRecordFileDB *self,
+                       const char *key,
+                       guint64 *out_value)
+{
+	guint i;
+
+	g_return_val_if_fail (self, FALSE);
+	g_return_val_if_fail (key, FALSE);
+
+	i = GPOINTER_TO_UINT (g_hash_table_lookup (self->idx, key));
+	if (i == 0)
+		return FALSE;
+
+	NM_SET_OUT (out_value, _record (self, i - 1)->value);
+	return TRUE;
+}
+
+gboolean
+nm_record_file_db_set (NMRecordFileDB *self,
+                       const char *key,
+                       guint64 value)
+{
+	FileRecord *r;
+	gsize l_key;
+	guint i;
+
+	g_return_val_if_fail (self, FALSE);
+	g_return_val_if_fail (key, FALSE);
+
+	if (!self->map)
+		return FALSE;
+
+	l_key = strlen (key);
+	if (   l_key == 0
+	    || l_key > NM_RECORD_FILE_DB_KEY_MAX_LEN)
+		return FALSE;
+
+	i = GPOINTER_TO_UINT (g_hash_table_lookup (self->idx, key));
+	if (i > 0) {
+		r = _record (self, i - 1);
+		if (r->value != value)
+			r->value = value;
+		return TRUE;
+	}
+
+	for (i = self->free_hint; i < self->n_records; i++) {
+		if (_record (self, i)->key[0] == '\0')
+			break;
+	}
+
+	if (i == self->n_records) {
+		guint n_records_old = self->n_records;
+
+		if (!_map (self, n_records_old * 2, TRUE)) {
+			/* the records are gone. */
+			g_hash_table_remove_all (self->idx);
+			return FALSE;
+		}
+		i = n_records_old;
+		_LOGD ("resized \"%s\" to %u records", self->filename, self->n_records);
+	}
+
+	self->free_hint = i + 1;
+
+	/* first write the value, then the key. The record only becomes valid
+	 * once it has a key. */
+	r = _record (self, i);
+	r->value = value;
+	memcpy (r->key, key, l_key + 1);
+
+	g_hash_table_insert (self->idx, g_strdup (key), GUINT_TO_POINTER (i + 1));
+	return TRUE;
+}
+
+void
+nm_record_file_db_remove (NMRecordFileDB *self,
+                          const char *key)
+{
+	guint i;
+
+	g_return_if_fail (self);
+
+	if (!key)
+		return;
+
+	i = GPOINTER_TO_UINT (g_hash_table_lookup (self->idx, key));
+	if (i == 0)
+		return;
+
+	i--;
+	memset (_record (self, i), 0, sizeof (FileRecord));
+	g_hash_table_remove (self->idx, key);
+	self->free_hint = NM_MIN (self->free_hint, i);
+}
+
+void
+nm_record_file_db_foreach (NMRecordFileDB *self,
+                           NMRecordFileDBForeachFcn foreach_fcn,
+                           gpointer user_data)
+{
+	guint i;
+
+	g_return_if_fail (self);
+	g_return_if_fail (foreach_fcn);
+
+	for (i = 0; i < self->n_records; i++) {
+		const FileRecord *r = _record (self, i);
+
+		if (r->key[0] != '\0')
+			foreach_fcn (r->key, r->value, user_data);
+	}
+}
+
+/* Normally, the kernel writes the modified pages back on its own. Call
+ * this to ensure the data is on disk (for example, before shutdown). */
+void
+nm_record_file_db_sync (NMRecordFileDB *self)
+{
+	int errsv;
+
+	g_return_if_fail (self);
+
+	if (!self->map)
+		return;
+
+	if (msync (self->map, self->map_len, MS_SYNC) != 0) {
+		errsv = errno;
+		_LOGD ("failure to sync \"%s\": %s", self->filename, nm_strerror_native (errsv));
+	}
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: LGPL-2.1+
+/*
+ * Copyright (C) 2020 Red Hat, Inc.
+ */
+
+#ifndef __NM_RECORD_FILE_DB_H__
+#define __NM_RECORD_FILE_DB_H__
+
+/*****************************************************************************/
+
+/* NMRecordFileDB is a small persistent store that maps short string keys
+ * (like connection UUIDs) to a 64 bit integer. Unlike NMKeyFileDB, the file
+ * consists of fixed size records and is memory mapped. An update only
+ * touches the record in place, instead of rewriting the entire file. */
+
+typedef struct _NMRecordFileDB NMRecordFileDB;
+
+#define NM_RECORD_FILE_DB_KEY_MAX_LEN 47
+
+typedef void (*NMRecordFileDBLogFcn) (NMRecordFileDB *self,
+                                      int syslog_level,
+                                      gpointer user_data,
+                                      const char *fmt,
+                                      ...) G_GNUC_PRINTF (4, 5);
+
+NMRecordFileDB *nm_record_file_db_new (const char *filename,
+                                       NMRecordFileDBLogFcn log_fcn,
+                                       gpointer user_data);
+
+gboolean nm_record_file_db_start (NMRecordFileDB *self);
+
+void nm_record_file_db_destroy (NMRecordFileDB *self);
+
+const char *nm_record_file_db_get_filename (NMRecordFileDB *self);
+
+guint nm_record_file_db_get_length (NMRecordFileDB *self);
+
+gboolean nm_record_file_db_get (NMRecordFileDB *self,
+                                const char *key,
+                                guint64 *out_value);
+
+gboolean nm_record_file_db_set (NMRecordFileDB *self,
+                                const char *key,
+                                guint64 value);
+
+void nm_record_file_db_remove (NMRecordFileDB *self,
+                               const char *key);
+
+typedef void (*NMRecordFileDBForeachFcn) (const char *key,
+                                          guint64 value,
+                                          gpointer user_data);
+
+void nm_record_file_db_foreach (NMRecordFileDB *self,
+                                NMRecordFileDBForeachFcn foreach_fcn,
+                                gpointer user_data);
+
+void nm_record_file_db_sync (NMRecordFileDB *self);
+
+/*****************************************************************************/
+
+#endif /* __NM_RECORD_FILE_DB_H__ */
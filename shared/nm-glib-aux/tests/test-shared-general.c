@@ -7,10 +7,13 @@
 
 #include "nm-default.h"
 
+#include <sys/stat.h>
+
 #include "nm-std-aux/unaligned.h"
 #include "nm-glib-aux/nm-random-utils.h"
 #include "nm-glib-aux/nm-time-utils.h"
 #include "nm-glib-aux/nm-ref-string.h"
+#include "nm-glib-aux/nm-record-file-db.h"
 
 #include "nm-utils/nm-test-utils.h"
 
@@ -584,6 +587,185 @@ test_string_table_lookup (void)
 
 /*****************************************************************************/
 
+static char *
+_record_file_db_tmpfile (void)
+{
+	GError *error = NULL;
+	char *filename = NULL;
+	int fd;
+
+	fd = g_file_open_tmp ("test-record-file-db-XXXXXX", &filename, &error);
+	nmtst_assert_success (fd >= 0, error);
+	nm_close (fd);
+	return filename;
+}
+
+static NMRecordFileDB *
+_record_file_db_open (const char *filename)
+{
+	NMRecordFileDB *db;
+
+	db = nm_record_file_db_new (filename, NULL, NULL);
+	g_assert (db);
+	g_assert (nm_record_file_db_start (db));
+	return db;
+}
+
+static void
+_record_file_db_foreach_cb (const char *key,
+                            guint64 value,
+                            gpointer user_data)
+{
+	g_ptr_array_add (user_data, g_strdup_printf ("%s=%"G_GUINT64_FORMAT, key, value));
+}
+
+static char *
+_record_file_db_dump (NMRecordFileDB *db)
+{
+	gs_unref_ptrarray GPtrArray *arr = g_ptr_array_new_with_free_func (g_free);
+
+	nm_record_file_db_foreach (db, _record_file_db_foreach_cb, arr);
+	g_ptr_array_add (arr, NULL);
+	return g_strjoinv (",", (char **) arr->pdata);
+}
+
+static gsize
+_record_file_db_file_size (const char *filename)
+{
+	struct stat st;
+
+	g_assert_cmpint (stat (filename, &st), ==, 0);
+	return st.st_size;
+}
+
+static void
+test_record_file_db_reopen (void)
+{
+	nmtst_auto_unlinkfile char *filename = _record_file_db_tmpfile ();
+	NMRecordFileDB *db;
+	guint64 value;
+
+	db = _record_file_db_open (filename);
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 0);
+
+	g_assert (nm_record_file_db_set (db, "a", 1));
+	g_assert (nm_record_file_db_set (db, "b", 2));
+	g_assert (nm_record_file_db_set (db, "a", 3));
+	g_assert (!nm_record_file_db_set (db, "", 4));
+	g_assert (!nm_record_file_db_set (db, "0123456789012345678901234567890123456789012345678", 5));
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 2);
+	g_assert (nm_record_file_db_get (db, "a", &value));
+	g_assert_cmpint (value, ==, 3);
+	nm_record_file_db_sync (db);
+	nm_record_file_db_destroy (db);
+
+	db = _record_file_db_open (filename);
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 2);
+	g_assert (nm_record_file_db_get (db, "a", &value));
+	g_assert_cmpint (value, ==, 3);
+	g_assert (nm_record_file_db_get (db, "b", &value));
+	g_assert_cmpint (value, ==, 2);
+	g_assert (!nm_record_file_db_get (db, "c", NULL));
+	nm_record_file_db_destroy (db);
+}
+
+static void
+test_record_file_db_resize (void)
+{
+	nmtst_auto_unlinkfile char *filename = _record_file_db_tmpfile ();
+	NMRecordFileDB *db;
+	gsize size_initial;
+	guint64 value;
+	char key[30];
+	guint i;
+
+	db = _record_file_db_open (filename);
+	size_initial = _record_file_db_file_size (filename);
+
+	for (i = 0; i < 300; i++)
+		g_assert (nm_record_file_db_set (db, nm_sprintf_buf (key, "key-%u", i), i));
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 300);
+	g_assert_cmpint (_record_file_db_file_size (filename), >, size_initial);
+	nm_record_file_db_destroy (db);
+
+	db = _record_file_db_open (filename);
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 300);
+	for (i = 0; i < 300; i++) {
+		g_assert (nm_record_file_db_get (db, nm_sprintf_buf (key, "key-%u", i), &value));
+		g_assert_cmpint (value, ==, i);
+	}
+	nm_record_file_db_destroy (db);
+}
+
+static void
+test_record_file_db_invalid (void)
+{
+	nmtst_auto_unlinkfile char *filename = _record_file_db_tmpfile ();
+	NMRecordFileDB *db;
+	gsize size;
+
+	/* garbage is reset to an empty database. */
+	nmtst_file_set_contents (filename, "this is not a record file, but it is longer than the header");
+	db = _record_file_db_open (filename);
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 0);
+	g_assert (nm_record_file_db_set (db, "a", 1));
+	g_assert (nm_record_file_db_set (db, "b", 2));
+	nm_record_file_db_destroy (db);
+
+	db = _record_file_db_open (filename);
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 2);
+	nm_record_file_db_destroy (db);
+
+	/* a truncated file does not match the size in the header. */
+	size = _record_file_db_file_size (filename);
+	g_assert_cmpint (truncate (filename, size - 1), ==, 0);
+	db = _record_file_db_open (filename);
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 0);
+	g_assert (!nm_record_file_db_get (db, "a", NULL));
+	nm_record_file_db_destroy (db);
+	g_assert_cmpint (_record_file_db_file_size (filename), ==, size);
+}
+
+static void
+test_record_file_db_remove (void)
+{
+	nmtst_auto_unlinkfile char *filename = _record_file_db_tmpfile ();
+	NMRecordFileDB *db;
+	char key[30];
+	guint i;
+	char *dump;
+
+	db = _record_file_db_open (filename);
+	for (i = 0; i < 6; i++)
+		g_assert (nm_record_file_db_set (db, nm_sprintf_buf (key, "k%u", i), i));
+
+	nm_record_file_db_remove (db, "k4");
+	nm_record_file_db_remove (db, "k1");
+	nm_record_file_db_remove (db, "k1");
+	nm_record_file_db_remove (db, "unknown");
+	g_assert_cmpint (nm_record_file_db_get_length (db), ==, 4);
+	g_assert (!nm_record_file_db_get (db, "k1", NULL));
+
+	/* the freed records get reused, starting with the lowest index. */
+	g_assert (nm_record_file_db_set (db, "a", 10));
+	g_assert (nm_record_file_db_set (db, "b", 11));
+	g_assert (nm_record_file_db_set (db, "c", 12));
+	dump = _record_file_db_dump (db);
+	g_assert_cmpstr (dump, ==, "k0=0,a=10,k2=2,k3=3,b=11,k5=5,c=12");
+	g_free (dump);
+	nm_record_file_db_destroy (db);
+
+	db = _record_file_db_open (filename);
+	nm_record_file_db_remove (db, "k0");
+	g_assert (nm_record_file_db_set (db, "d", 13));
+	dump = _record_file_db_dump (db);
+	g_assert_cmpstr (dump, ==, "d=13,a=10,k2=2,k3=3,b=11,k5=5,c=12");
+	g_free (dump);
+	nm_record_file_db_destroy (db);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int main (int argc, char **argv)
@@ -603,6 +785,10 @@ int main (int argc, char **argv)
 	g_test_add_func ("/general/test_nm_utils_bin2hexstr", test_nm_utils_bin2hexstr);
 	g_test_add_func ("/general/test_nm_ref_string", test_nm_ref_string);
 	g_test_add_func ("/general/test_string_table_lookup", test_string_table_lookup);
+	g_test_add_func ("/general/record-file-db/reopen", test_record_file_db_reopen);
+	g_test_add_func ("/general/record-file-db/resize", test_record_file_db_resize);
+	g_test_add_func ("/general/record-file-db/invalid", test_record_file_db_invalid);
+	g_test_add_func ("/general/record-file-db/remove", test_record_file_db_remove);
 
 	return g_test_run ();
 }
@@ -26,6 +26,10 @@
 #define NM_AUTH_PERMISSION_ENABLE_DISABLE_CONNECTIVITY_CHECK "org.freedesktop.NetworkManager.enable-disable-connectivity-check"
 #define NM_AUTH_PERMISSION_WIFI_SCAN                  "org.freedesktop.NetworkManager.wifi.scan"
 
+/* a private D-Bus socket for local root clients, which exports the same
+ * objects as NetworkManager does on the system bus. */
+#define NM_DBUS_PRIVATE_CLIENT_SOCKET NMRUNDIR "/private-client"
+
 #define NM_CLONED_MAC_PRESERVE                          "preserve"
 #define NM_CLONED_MAC_PERMANENT                         "permanent"
 #define NM_CLONED_MAC_RANDOM                            "random"
@@ -868,7 +868,7 @@ int
 nm_match_spec_device_by_pllink (const NMPlatformLink *pllink,
                                 const char *match_device_type,
                                 const char *match_dhcp_plugin,
-                                const GSList *specs,
+                                const NMMatchSpecDevice *match_spec,
                                 int no_match_value)
 {
 	NMMatchSpecMatchType m;
@@ -878,14 +878,14 @@ nm_match_spec_device_by_pllink (const NMPlatformLink *pllink,
 	 *
 	 * It's still useful because of specs like "*" and "except:interface-name:eth0",
 	 * which match even in that case. */
-	m = nm_match_spec_device (specs,
-	                          pllink ? pllink->name : NULL,
-	                          match_device_type,
-	                          pllink ? pllink->driver : NULL,
-	                          NULL,
-	                          NULL,
-	                          NULL,
-	                          match_dhcp_plugin);
+	m = nm_match_spec_device_match (match_spec,
+	                                pllink ? pllink->name : NULL,
+	                                match_device_type,
+	                                pllink ? pllink->driver : NULL,
+	                                NULL,
+	                                NULL,
+	                                NULL,
+	                                match_dhcp_plugin);
 
 	switch (m) {
 	case NM_MATCH_SPEC_MATCH:
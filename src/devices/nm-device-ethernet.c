@@ -627,6 +627,7 @@ supplicant_iface_state_is_completed (NMDeviceEthernet *self,
 	NMDeviceEthernetPrivate *priv = NM_DEVICE_ETHERNET_GET_PRIVATE (self);
 
 	if (state == NM_SUPPLICANT_INTERFACE_STATE_COMPLETED) {
+		nm_device_activation_timeline_add (NM_DEVICE (self), "supplicant-completed");
 		nm_clear_g_source (&priv->supplicant.lnk_timeout_id);
 		nm_clear_g_source (&priv->supplicant.con_timeout_id);
 
@@ -97,6 +97,8 @@ dhcp_grace_period_from_timeout (guint32 timeout)
 #define NM_DEVICE_AUTH_RETRIES_INFINITY -2
 #define NM_DEVICE_AUTH_RETRIES_DEFAULT  3
 
+#define ACTIVATION_TIMELINE_MAX 24
+
 /*****************************************************************************/
 
 typedef void (*ActivationHandleFunc) (NMDevice *self);
@@ -107,6 +109,11 @@ typedef enum {
 	CLEANUP_TYPE_DECONFIGURE,
 } CleanupType;
 
+typedef struct {
+	CList lst;
+	NMDevice *self;
+} QueuedIPConfigData;
+
 typedef struct {
 	CList lst_slave;
 	NMDevice *slave;
@@ -186,6 +193,13 @@ typedef struct {
 	NMTernary requested[_NM_ETHTOOL_ID_FEATURE_NUM];
 } EthtoolState;
 
+typedef struct {
+	/* the devices that refresh their statistics at this rate. */
+	GPtrArray *devices;
+	guint refresh_rate_ms;
+	guint timeout_id;
+} StatsGroup;
+
 /*****************************************************************************/
 
 enum {
@@ -247,6 +261,7 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMDevice,
 	PROP_IP4_CONNECTIVITY,
 	PROP_IP6_CONNECTIVITY,
 	PROP_INTERFACE_FLAGS,
+	PROP_ACTIVATION_TIMELINE,
 );
 
 typedef struct _NMDevicePrivate {
@@ -265,13 +280,21 @@ typedef struct _NMDevicePrivate {
 		NMDeviceStateReason reason;
 	} queued_state;
 
-	union {
+	/* linked into the global queue of pending IP config changes
+	 * (see _queued_ip_config_schedule()). */
+	QueuedIPConfigData queued_ip_config_x[2];
+
+	/* Timestamps of the steps of the current activation, relative to
+	 * entering the PREPARE state. @start_msec is zero, when no activation
+	 * is being tracked. */
+	struct {
+		gint64 start_msec;
+		guint n_events;
 		struct {
-			guint queued_ip_config_id_6;
-			guint queued_ip_config_id_4;
-		};
-		guint queued_ip_config_id_x[2];
-	};
+			const char *event;
+			gint64 delta_msec;
+		} events[ACTIVATION_TIMELINE_MAX];
+	} activation_timeline;
 
 	GSList *pending_actions;
 	GSList *dad6_failed_addrs;
@@ -611,7 +634,7 @@ typedef struct _NMDevicePrivate {
 	} sriov;
 
 	struct {
-		guint timeout_id;
+		StatsGroup *group;
 		guint refresh_rate_ms;
 		guint64 tx_bytes;
 		guint64 rx_bytes;
@@ -658,8 +681,9 @@ static void _set_state_full (NMDevice *self,
                              NMDeviceStateReason reason,
                              gboolean quitting);
 static void queued_state_clear (NMDevice *device);
-static gboolean queued_ip4_config_change (gpointer user_data);
-static gboolean queued_ip6_config_change (gpointer user_data);
+static gboolean _queued_ip_config_is_pending (NMDevice *self, int addr_family);
+static gboolean _queued_ip_config_schedule (NMDevice *self, int addr_family);
+static gboolean _queued_ip_config_clear (NMDevice *self, int addr_family);
 static void ip_check_ping_watch_cb (GPid pid, int status, gpointer user_data);
 static gboolean ip_config_valid (NMDeviceState state);
 static NMActStageReturn dhcp4_start (NMDevice *self);
@@ -1866,6 +1890,12 @@ _stats_update_counters (NMDevice *self,
 
 	priv = NM_DEVICE_GET_PRIVATE (self);
 
+	if (   priv->stats.tx_bytes == tx_bytes
+	    && priv->stats.rx_bytes == rx_bytes)
+		return;
+
+	/* emit one PropertiesChanged signal for both counters. */
+	g_object_freeze_notify ((GObject *) self);
 	if (priv->stats.tx_bytes != tx_bytes) {
 		priv->stats.tx_bytes = tx_bytes;
 		_notify (self, PROP_STATISTICS_TX_BYTES);
@@ -1874,6 +1904,7 @@ _stats_update_counters (NMDevice *self,
 		priv->stats.rx_bytes = rx_bytes;
 		_notify (self, PROP_STATISTICS_RX_BYTES);
 	}
+	g_object_thaw_notify ((GObject *) self);
 }
 
 static void
@@ -1882,22 +1913,127 @@ _stats_update_counters_from_pllink (NMDevice *self, const NMPlatformLink *pllink
 	_stats_update_counters (self, pllink->tx_bytes, pllink->rx_bytes);
 }
 
+/* All devices with the same refresh rate share one timer. On each tick,
+ * we either issue one RTM_GETLINK request per device, or request all links
+ * with one dump. The cost of a dump grows with the number of links on the
+ * system, so only dump when the group covers a large enough share of them. */
+#define STATS_REFRESH_ALL_MIN_DEVICES          4
+#define STATS_REFRESH_ALL_MAX_LINKS_PER_DEVICE 4
+
+static GHashTable *_stats_groups;
+
 static gboolean
-_stats_timeout_cb (gpointer user_data)
+_stats_group_use_dump (StatsGroup *group, NMPlatform *platform)
 {
-	NMDevice *self = user_data;
-	int ifindex;
+	const NMDedupMultiHeadEntry *head_entry;
+	guint n_devices = 0;
+	guint i;
 
-	ifindex = nm_device_get_ip_ifindex (self);
+	for (i = 0; i < group->devices->len; i++) {
+		NMDevice *self = group->devices->pdata[i];
 
-	_LOGT (LOGD_DEVICE, "stats: refresh %d", ifindex);
+		if (   nm_device_get_platform (self) == platform
+		    && nm_device_get_ip_ifindex (self) > 0)
+			n_devices++;
+	}
 
-	if (ifindex > 0)
-		nm_platform_link_refresh (nm_device_get_platform (self), ifindex);
+	if (n_devices < STATS_REFRESH_ALL_MIN_DEVICES)
+		return FALSE;
+
+	head_entry = nm_platform_lookup_obj_type (platform, NMP_OBJECT_TYPE_LINK);
+	return    !head_entry
+	       || head_entry->len <= n_devices * STATS_REFRESH_ALL_MAX_LINKS_PER_DEVICE;
+}
+
+static gboolean
+_stats_group_timeout_cb (gpointer user_data)
+{
+	StatsGroup *group = user_data;
+	NMPlatform *platform_dump = NULL;
+	guint i;
+
+	if (group->devices->len >= STATS_REFRESH_ALL_MIN_DEVICES) {
+		/* all devices usually share the same platform instance. */
+		platform_dump = nm_device_get_platform (group->devices->pdata[0]);
+		if (!_stats_group_use_dump (group, platform_dump))
+			platform_dump = NULL;
+	}
+
+	nm_log_trace (LOGD_DEVICE, "stats: refresh %u devices at %u ms%s",
+	              group->devices->len,
+	              group->refresh_rate_ms,
+	              platform_dump ? " (dump all links)" : "");
+
+	for (i = 0; i < group->devices->len; i++) {
+		NMDevice *self = group->devices->pdata[i];
+		NMPlatform *platform = nm_device_get_platform (self);
+		int ifindex;
+
+		if (platform == platform_dump)
+			continue;
+
+		ifindex = nm_device_get_ip_ifindex (self);
+		if (ifindex <= 0)
+			continue;
+
+		nm_platform_link_refresh (platform, ifindex);
+	}
+
+	if (platform_dump)
+		nm_platform_link_refresh_all (platform_dump);
 
 	return G_SOURCE_CONTINUE;
 }
 
+static void
+_stats_group_detach (NMDevice *self)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	StatsGroup *group;
+
+	group = g_steal_pointer (&priv->stats.group);
+	if (!group)
+		return;
+
+	if (!g_ptr_array_remove_fast (group->devices, self))
+		nm_assert_not_reached ();
+
+	if (group->devices->len > 0)
+		return;
+
+	g_hash_table_remove (_stats_groups, GUINT_TO_POINTER (group->refresh_rate_ms));
+	nm_clear_g_source (&group->timeout_id);
+	g_ptr_array_unref (group->devices);
+	g_slice_free (StatsGroup, group);
+}
+
+static void
+_stats_group_attach (NMDevice *self, guint refresh_rate_ms)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	StatsGroup *group;
+
+	nm_assert (refresh_rate_ms > 0);
+	nm_assert (!priv->stats.group);
+
+	if (G_UNLIKELY (!_stats_groups))
+		_stats_groups = g_hash_table_new (nm_direct_hash, NULL);
+
+	group = g_hash_table_lookup (_stats_groups, GUINT_TO_POINTER (refresh_rate_ms));
+	if (!group) {
+		group = g_slice_new (StatsGroup);
+		*group = (StatsGroup) {
+			.devices         = g_ptr_array_new (),
+			.refresh_rate_ms = refresh_rate_ms,
+		};
+		group->timeout_id = g_timeout_add (refresh_rate_ms, _stats_group_timeout_cb, group);
+		g_hash_table_insert (_stats_groups, GUINT_TO_POINTER (refresh_rate_ms), group);
+	}
+
+	g_ptr_array_add (group->devices, self);
+	priv->stats.group = group;
+}
+
 static guint
 _stats_refresh_rate_real (guint refresh_rate_ms)
 {
@@ -1940,7 +2076,7 @@ _stats_set_refresh_rate (NMDevice *self, guint refresh_rate_ms)
 	if (_stats_refresh_rate_real (old_rate) == refresh_rate_ms)
 		return;
 
-	nm_clear_g_source (&priv->stats.timeout_id);
+	_stats_group_detach (self);
 
 	if (!refresh_rate_ms)
 		return;
@@ -1952,7 +2088,7 @@ _stats_set_refresh_rate (NMDevice *self, guint refresh_rate_ms)
 	if (ifindex > 0)
 		nm_platform_link_refresh (nm_device_get_platform (self), ifindex);
 
-	priv->stats.timeout_id = g_timeout_add (refresh_rate_ms, _stats_timeout_cb, self);
+	_stats_group_attach (self, refresh_rate_ms);
 }
 
 /*****************************************************************************/
@@ -4591,8 +4727,8 @@ realize_start_setup (NMDevice *self,
 	g_return_if_fail (nm_device_get_unmanaged_flags (self, NM_UNMANAGED_PLATFORM_INIT));
 	g_return_if_fail (priv->ip_ifindex <= 0);
 	g_return_if_fail (priv->ip_iface == NULL);
-	g_return_if_fail (!priv->queued_ip_config_id_4);
-	g_return_if_fail (!priv->queued_ip_config_id_6);
+	g_return_if_fail (!_queued_ip_config_is_pending (self, AF_INET));
+	g_return_if_fail (!_queued_ip_config_is_pending (self, AF_INET6));
 
 	_LOGD (LOGD_DEVICE, "start setup of %s, kernel ifindex %d", G_OBJECT_TYPE_NAME (self), plink ? plink->ifindex : 0);
 
@@ -4679,10 +4815,10 @@ realize_start_setup (NMDevice *self,
 
 	nm_device_set_carrier_from_platform (self);
 
-	nm_assert (!priv->stats.timeout_id);
+	nm_assert (!priv->stats.group);
 	real_rate = _stats_refresh_rate_real (priv->stats.refresh_rate_ms);
 	if (real_rate)
-		priv->stats.timeout_id = g_timeout_add (real_rate, _stats_timeout_cb, self);
+		_stats_group_attach (self, real_rate);
 
 	klass->realize_start_notify (self, plink);
 
@@ -4838,8 +4974,8 @@ nm_device_unrealize (NMDevice *self, gboolean remove_resources, GError **error)
 		}
 	}
 
-	nm_clear_g_source (&priv->queued_ip_config_id_4);
-	nm_clear_g_source (&priv->queued_ip_config_id_6);
+	_queued_ip_config_clear (self, AF_INET);
+	_queued_ip_config_clear (self, AF_INET6);
 
 	g_object_freeze_notify (G_OBJECT (self));
 	NM_DEVICE_GET_CLASS (self)->unrealize_notify (self);
@@ -4873,7 +5009,7 @@ nm_device_unrealize (NMDevice *self, gboolean remove_resources, GError **error)
 		_notify (self, PROP_PHYSICAL_PORT_ID);
 	}
 
-	nm_clear_g_source (&priv->stats.timeout_id);
+	_stats_group_detach (self);
 	_stats_update_counters (self, 0, 0);
 
 	priv->hw_addr_len_ = 0;
@@ -7218,6 +7354,8 @@ acd_manager_probe_terminated (NMAcdManager *acd_manager, gpointer user_data)
 	self = data->device;
 	priv = NM_DEVICE_GET_PRIVATE (self);
 
+	nm_device_activation_timeline_add (self, "acd-probe");
+
 	for (i = 0; data->configs && data->configs[i]; i++) {
 		nm_ip_config_iter_ip4_address_for_each (&ipconf_iter, data->configs[i], &address) {
 			char sbuf[NM_UTILS_INET_ADDRSTRLEN];
@@ -7687,7 +7825,7 @@ ip_config_merge_and_apply (NMDevice *self,
 	init_ip_config_dns_priority (self, composite);
 
 	if (commit) {
-		if (priv->queued_ip_config_id_x[IS_IPv4])
+		if (_queued_ip_config_is_pending (self, addr_family))
 			update_ext_ip_config (self, addr_family, FALSE);
 		ensure_con_ip_config (self, addr_family);
 	}
@@ -8040,6 +8178,7 @@ dhcp4_state_changed (NMDhcpClient *client,
 	switch (state) {
 	case NM_DHCP_STATE_BOUND:
 	case NM_DHCP_STATE_EXTENDED:
+		nm_device_activation_timeline_add (self, "dhcp4-lease");
 		if (!ip4_config) {
 			_LOGW (LOGD_DHCP4, "failed to get IPv4 config in response to DHCP event.");
 			dhcp4_fail (self, state);
@@ -8800,6 +8939,7 @@ dhcp6_state_changed (NMDhcpClient *client,
 	switch (state) {
 	case NM_DHCP_STATE_BOUND:
 	case NM_DHCP_STATE_EXTENDED:
+		nm_device_activation_timeline_add (self, "dhcp6-lease");
 		nm_clear_g_source (&priv->dhcp_data_6.grace_id);
 		priv->dhcp_data_6.grace_pending = FALSE;
 		/* If the server sends multiple IPv6 addresses, we receive a state
@@ -9967,6 +10107,8 @@ ndisc_config_changed (NMNDisc *ndisc, const NMNDiscData *rdata, guint changed_in
 
 	g_return_if_fail (priv->act_request.obj);
 
+	nm_device_activation_timeline_add (self, "ndisc-config");
+
 	if (!applied_config_get_current (&priv->ac_ip6_config))
 		applied_config_init_new (&priv->ac_ip6_config, self, AF_INET6);
 
@@ -10807,6 +10949,8 @@ fw_change_zone_cb (NMFirewallManager *firewall_manager,
 	if (nm_utils_error_is_cancelled (error))
 		return;
 
+	nm_device_activation_timeline_add (self, "firewall-zone");
+
 	switch (priv->fw_state) {
 	case FIREWALL_STATE_WAIT_STAGE_3:
 		priv->fw_state = FIREWALL_STATE_INITIALIZED;
@@ -11613,7 +11757,7 @@ _cleanup_ip_pre (NMDevice *self, int addr_family, CleanupType cleanup_type)
 
 	_set_ip_state (self, addr_family, NM_DEVICE_IP_STATE_NONE);
 
-	if (nm_clear_g_source (&priv->queued_ip_config_id_x[IS_IPv4])) {
+	if (_queued_ip_config_clear (self, addr_family)) {
 		_LOGD (LOGD_DEVICE, "clearing queued IP%c config change",
 		       nm_utils_addr_family_to_char (addr_family));
 	}
@@ -13119,6 +13263,7 @@ dispatcher_complete_proceed_state (NMDispatcherCallId *call_id, gpointer user_da
 	g_return_if_fail (call_id == priv->dispatcher.call_id);
 
 	priv->dispatcher.call_id = NULL;
+	nm_device_activation_timeline_add (self, "dispatcher-pre-up");
 	nm_device_queue_state (self,
 	                       priv->dispatcher.post_state,
 	                       priv->dispatcher.post_state_reason);
@@ -13764,8 +13909,6 @@ queued_ip_config_change (NMDevice *self, int addr_family)
 	    && priv->activation_source_func_x[IS_IPv4] == activate_stage5_ip_config_result_x[IS_IPv4])
 		return G_SOURCE_CONTINUE;
 
-	priv->queued_ip_config_id_x[IS_IPv4] = 0;
-
 	update_ip_config (self, addr_family);
 
 	if (!IS_IPv4) {
@@ -13850,16 +13993,99 @@ queued_ip_config_change (NMDevice *self, int addr_family)
 	return G_SOURCE_REMOVE;
 }
 
+/* All devices share one queue of pending IP config changes per address family,
+ * which is processed by a single idle handler. That way, when a shared event
+ * (like a change of the default route metric or of the DNS priority) touches
+ * many devices, their addresses and routes are synced in one pass over all
+ * devices instead of one idle source per device and address family. */
+static CList _queued_ip_config_lst_head_x[2] = {
+	C_LIST_INIT (_queued_ip_config_lst_head_x[0]),
+	C_LIST_INIT (_queued_ip_config_lst_head_x[1]),
+};
+static guint _queued_ip_config_idle_id;
+
 static gboolean
-queued_ip4_config_change (gpointer user_data)
+_queued_ip_config_idle_cb (gpointer user_data)
 {
-	return queued_ip_config_change (user_data, AF_INET);
+	int IS_IPv4;
+
+	_queued_ip_config_idle_id = 0;
+
+	/* sync IPv4 of all devices first, then IPv6. */
+	for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+		CList batch_lst_head = C_LIST_INIT (batch_lst_head);
+		CList batch_child_lst_head = C_LIST_INIT (batch_child_lst_head);
+		QueuedIPConfigData *data;
+		QueuedIPConfigData *data_safe;
+
+		c_list_splice (&batch_lst_head, &_queued_ip_config_lst_head_x[IS_IPv4]);
+
+		/* devices on top of a parent device (VLAN, MACVLAN, ...) go last, so that
+		 * the addresses and routes of the parent are already synced. */
+		c_list_for_each_entry_safe (data, data_safe, &batch_lst_head, lst) {
+			if (nm_device_parent_get_device (data->self)) {
+				c_list_unlink_stale (&data->lst);
+				c_list_link_tail (&batch_child_lst_head, &data->lst);
+			}
+		}
+		c_list_splice (&batch_lst_head, &batch_child_lst_head);
+
+		/* devices may get removed from the batch while processing another
+		 * device, so always take the first remaining entry. */
+		while ((data = c_list_first_entry (&batch_lst_head, QueuedIPConfigData, lst))) {
+			gs_unref_object NMDevice *self = g_object_ref (data->self);
+
+			c_list_unlink (&data->lst);
+
+			if (queued_ip_config_change (self, IS_IPv4 ? AF_INET : AF_INET6) == G_SOURCE_CONTINUE) {
+				/* postponed. Retry on the next iteration of the main loop. */
+				_queued_ip_config_schedule (self, IS_IPv4 ? AF_INET : AF_INET6);
+			}
+		}
+	}
+
+	return G_SOURCE_REMOVE;
 }
 
 static gboolean
-queued_ip6_config_change (gpointer user_data)
+_queued_ip_config_is_pending (NMDevice *self, int addr_family)
 {
-	return queued_ip_config_change (user_data, AF_INET6);
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
+
+	return !c_list_is_empty (&priv->queued_ip_config_x[IS_IPv4].lst);
+}
+
+static gboolean
+_queued_ip_config_schedule (NMDevice *self, int addr_family)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
+
+	if (_queued_ip_config_is_pending (self, addr_family))
+		return FALSE;
+
+	c_list_link_tail (&_queued_ip_config_lst_head_x[IS_IPv4],
+	                  &priv->queued_ip_config_x[IS_IPv4].lst);
+	if (!_queued_ip_config_idle_id)
+		_queued_ip_config_idle_id = g_idle_add (_queued_ip_config_idle_cb, NULL);
+	return TRUE;
+}
+
+static gboolean
+_queued_ip_config_clear (NMDevice *self, int addr_family)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
+
+	if (!_queued_ip_config_is_pending (self, addr_family))
+		return FALSE;
+
+	c_list_unlink (&priv->queued_ip_config_x[IS_IPv4].lst);
+	if (   c_list_is_empty (&_queued_ip_config_lst_head_x[0])
+	    && c_list_is_empty (&_queued_ip_config_lst_head_x[1]))
+		nm_clear_g_source (&_queued_ip_config_idle_id);
+	return TRUE;
 }
 
 static void
@@ -13891,10 +14117,8 @@ device_ipx_changed (NMPlatform *platform,
 	switch (obj_type) {
 	case NMP_OBJECT_TYPE_IP4_ADDRESS:
 	case NMP_OBJECT_TYPE_IP4_ROUTE:
-		if (!priv->queued_ip_config_id_4) {
-			priv->queued_ip_config_id_4 = g_idle_add (queued_ip4_config_change, self);
+		if (_queued_ip_config_schedule (self, AF_INET))
 			_LOGD (LOGD_DEVICE, "queued IP4 config change");
-		}
 		break;
 	case NMP_OBJECT_TYPE_IP6_ADDRESS:
 		addr = platform_object;
@@ -13908,10 +14132,8 @@ device_ipx_changed (NMPlatform *platform,
 
 		/* fall-through */
 	case NMP_OBJECT_TYPE_IP6_ROUTE:
-		if (!priv->queued_ip_config_id_6) {
-			priv->queued_ip_config_id_6 = g_idle_add (queued_ip6_config_change, self);
+		if (_queued_ip_config_schedule (self, AF_INET6))
 			_LOGD (LOGD_DEVICE, "queued IP6 config change");
-		}
 		break;
 	default:
 		g_return_if_reached ();
@@ -14179,10 +14401,10 @@ _set_unmanaged_flags (NMDevice *self,
 		}
 
 		/* trigger an initial update of IP configuration. */
-		nm_assert_se (!nm_clear_g_source (&priv->queued_ip_config_id_4));
-		nm_assert_se (!nm_clear_g_source (&priv->queued_ip_config_id_6));
-		priv->queued_ip_config_id_4 = g_idle_add (queued_ip4_config_change, self);
-		priv->queued_ip_config_id_6 = g_idle_add (queued_ip6_config_change, self);
+		nm_assert (!_queued_ip_config_is_pending (self, AF_INET));
+		nm_assert (!_queued_ip_config_is_pending (self, AF_INET6));
+		_queued_ip_config_schedule (self, AF_INET);
+		_queued_ip_config_schedule (self, AF_INET6);
 
 		if (!priv->pending_actions) {
 			do_notify_has_pending_actions = TRUE;
@@ -15638,6 +15860,81 @@ deactivate_dispatcher_complete (NMDispatcherCallId *call_id, gpointer user_data)
 		deactivate_ready (self, reason);
 }
 
+/**
+ * nm_device_activation_timeline_add:
+ * @self: the #NMDevice
+ * @event: a static string naming the event
+ *
+ * Records the time of @event for the currently ongoing activation. The
+ * timeline is exposed as the ActivationTimeline D-Bus property, and logged
+ * when the activation completes. Outside of an activation, this does nothing.
+ *
+ * To not rebuild and send the property for every event, the property is
+ * only notified on device state changes. Events recorded in between show
+ * up with the next state change.
+ */
+void
+nm_device_activation_timeline_add (NMDevice *self, const char *event)
+{
+	NMDevicePrivate *priv;
+
+	g_return_if_fail (NM_IS_DEVICE (self));
+	nm_assert (event);
+
+	priv = NM_DEVICE_GET_PRIVATE (self);
+
+	if (   priv->activation_timeline.start_msec == 0
+	    || priv->activation_timeline.n_events >= ACTIVATION_TIMELINE_MAX)
+		return;
+
+	priv->activation_timeline.events[priv->activation_timeline.n_events].event = event;
+	priv->activation_timeline.events[priv->activation_timeline.n_events].delta_msec =   nm_utils_get_monotonic_timestamp_msec ()
+	                                                                                 - priv->activation_timeline.start_msec;
+	priv->activation_timeline.n_events++;
+}
+
+static void
+_activation_timeline_state_changed (NMDevice *self, NMDeviceState state)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	nm_auto_free_gstring GString *str = NULL;
+	guint i;
+
+	if (state == NM_DEVICE_STATE_PREPARE) {
+		priv->activation_timeline.start_msec = nm_utils_get_monotonic_timestamp_msec ();
+		priv->activation_timeline.n_events = 0;
+	}
+
+	if (priv->activation_timeline.start_msec == 0)
+		return;
+
+	nm_device_activation_timeline_add (self, nm_device_state_to_str (state));
+	_notify (self, PROP_ACTIVATION_TIMELINE);
+
+	if (!NM_IN_SET (state, NM_DEVICE_STATE_ACTIVATED,
+	                       NM_DEVICE_STATE_FAILED,
+	                       NM_DEVICE_STATE_DEACTIVATING,
+	                       NM_DEVICE_STATE_DISCONNECTED,
+	                       NM_DEVICE_STATE_UNAVAILABLE,
+	                       NM_DEVICE_STATE_UNMANAGED))
+		return;
+
+	priv->activation_timeline.start_msec = 0;
+
+	if (!_LOGD_ENABLED (LOGD_DEVICE))
+		return;
+
+	str = g_string_new (NULL);
+	for (i = 0; i < priv->activation_timeline.n_events; i++) {
+		g_string_append_printf (str,
+		                        "%s%s +%"G_GINT64_FORMAT"ms",
+		                        i > 0 ? ", " : "",
+		                        priv->activation_timeline.events[i].event,
+		                        priv->activation_timeline.events[i].delta_msec);
+	}
+	_LOGD (LOGD_DEVICE, "Activation: timeline: %s", str->str);
+}
+
 static void
 _set_state_full (NMDevice *self,
                  NMDeviceState state,
@@ -15701,6 +15998,8 @@ _set_state_full (NMDevice *self,
 	priv->state = state;
 	priv->state_reason = reason;
 
+	_activation_timeline_state_changed (self, state);
+
 	queued_state_clear (self);
 
 	dispatcher_cleanup (self);
@@ -16858,29 +17157,44 @@ nm_device_spec_match_list (NMDevice *self, const GSList *specs)
 	return nm_device_spec_match_list_full (self, specs, FALSE);
 }
 
-int
-nm_device_spec_match_list_full (NMDevice *self, const GSList *specs, int no_match_value)
+static int
+_spec_match (NMDevice *self,
+             const GSList *specs,
+             const NMMatchSpecDevice *match_spec,
+             int no_match_value)
 {
 	NMDeviceClass *klass;
 	NMMatchSpecMatchType m;
 	const char *hw_address = NULL;
 	gboolean is_fake;
 
-	g_return_val_if_fail (NM_IS_DEVICE (self), FALSE);
-
 	klass = NM_DEVICE_GET_CLASS (self);
 	hw_address = nm_device_get_permanent_hw_address_full (self,
 	                                                      !nm_device_get_unmanaged_flags (self, NM_UNMANAGED_PLATFORM_INIT),
 	                                                      &is_fake);
-
-	m = nm_match_spec_device (specs,
-	                          nm_device_get_iface (self),
-	                          nm_device_get_type_description (self),
-	                          nm_device_get_driver (self),
-	                          nm_device_get_driver_version (self),
-	                          is_fake ? NULL : hw_address,
-	                          klass->get_s390_subchannels ? klass->get_s390_subchannels (self) : NULL,
-	                          nm_dhcp_manager_get_config (nm_dhcp_manager_get ()));
+	if (is_fake)
+		hw_address = NULL;
+
+	if (match_spec) {
+		nm_assert (!specs);
+		m = nm_match_spec_device_match (match_spec,
+		                                nm_device_get_iface (self),
+		                                nm_device_get_type_description (self),
+		                                nm_device_get_driver (self),
+		                                nm_device_get_driver_version (self),
+		                                hw_address,
+		                                klass->get_s390_subchannels ? klass->get_s390_subchannels (self) : NULL,
+		                                nm_dhcp_manager_get_config (nm_dhcp_manager_get ()));
+	} else {
+		m = nm_match_spec_device (specs,
+		                          nm_device_get_iface (self),
+		                          nm_device_get_type_description (self),
+		                          nm_device_get_driver (self),
+		                          nm_device_get_driver_version (self),
+		                          hw_address,
+		                          klass->get_s390_subchannels ? klass->get_s390_subchannels (self) : NULL,
+		                          nm_dhcp_manager_get_config (nm_dhcp_manager_get ()));
+	}
 
 	switch (m) {
 	case NM_MATCH_SPEC_MATCH:
@@ -16894,6 +17208,59 @@ nm_device_spec_match_list_full (NMDevice *self, const GSList *specs, int no_matc
 	return no_match_value;
 }
 
+/**
+ * nm_device_get_spec_match_values:
+ * @self: the #NMDevice
+ * @out_values: (out): filled with the %NM_DEVICE_SPEC_MATCH_N_VALUES
+ *   properties of the device that are relevant for matching device specs.
+ *   Two devices with the same values match the same specs. The strings
+ *   are owned by the device and are only valid until it changes.
+ */
+void
+nm_device_get_spec_match_values (NMDevice *self,
+                                 const char *out_values[static NM_DEVICE_SPEC_MATCH_N_VALUES])
+{
+	NMDeviceClass *klass;
+	const char *hw_address;
+	gboolean is_fake;
+
+	g_return_if_fail (NM_IS_DEVICE (self));
+
+	klass = NM_DEVICE_GET_CLASS (self);
+	hw_address = nm_device_get_permanent_hw_address_full (self,
+	                                                      !nm_device_get_unmanaged_flags (self, NM_UNMANAGED_PLATFORM_INIT),
+	                                                      &is_fake);
+
+	/* must contain the same values as used by _spec_match(). */
+	out_values[0] = nm_device_get_iface (self);
+	out_values[1] = nm_device_get_type_description (self);
+	out_values[2] = nm_device_get_driver (self);
+	out_values[3] = nm_device_get_driver_version (self);
+	out_values[4] = is_fake ? NULL : hw_address;
+	out_values[5] = klass->get_s390_subchannels ? klass->get_s390_subchannels (self) : NULL;
+	out_values[6] = nm_dhcp_manager_get_config (nm_dhcp_manager_get ());
+}
+
+int
+nm_device_spec_match_list_full (NMDevice *self, const GSList *specs, int no_match_value)
+{
+	g_return_val_if_fail (NM_IS_DEVICE (self), FALSE);
+
+	return _spec_match (self, specs, NULL, no_match_value);
+}
+
+/* like nm_device_spec_match_list_full(), but with specs that were
+ * compiled by nm_match_spec_device_new(). */
+int
+nm_device_spec_match_compiled_full (NMDevice *self, const NMMatchSpecDevice *match_spec, int no_match_value)
+{
+	g_return_val_if_fail (NM_IS_DEVICE (self), FALSE);
+
+	if (!match_spec)
+		return no_match_value;
+	return _spec_match (self, NULL, match_spec, no_match_value);
+}
+
 guint
 nm_device_get_supplicant_timeout (NMDevice *self)
 {
@@ -16998,6 +17365,7 @@ get_property (GObject *object, guint prop_id,
 	NMDevice *self = NM_DEVICE (object);
 	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
 	GVariantBuilder array_builder;
+	guint i;
 
 	switch (prop_id) {
 	case PROP_UDI:
@@ -17185,6 +17553,16 @@ get_property (GObject *object, guint prop_id,
 	case PROP_INTERFACE_FLAGS:
 		g_value_set_uint (value, priv->interface_flags);
 		break;
+	case PROP_ACTIVATION_TIMELINE:
+		g_variant_builder_init (&array_builder, G_VARIANT_TYPE ("a(su)"));
+		for (i = 0; i < priv->activation_timeline.n_events; i++) {
+			g_variant_builder_add (&array_builder,
+			                       "(su)",
+			                       priv->activation_timeline.events[i].event,
+			                       (guint32) MIN (priv->activation_timeline.events[i].delta_msec, (gint64) G_MAXUINT32));
+		}
+		g_value_take_variant (value, g_variant_builder_end (&array_builder));
+		break;
 	default:
 		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 		break;
@@ -17294,6 +17672,10 @@ nm_device_init (NMDevice *self)
 	c_list_init (&priv->concheck_lst_head);
 	c_list_init (&self->devices_lst);
 	c_list_init (&priv->slaves);
+	c_list_init (&priv->queued_ip_config_x[0].lst);
+	c_list_init (&priv->queued_ip_config_x[1].lst);
+	priv->queued_ip_config_x[0].self = self;
+	priv->queued_ip_config_x[1].self = self;
 
 	priv->concheck_x[0].state = NM_CONNECTIVITY_UNKNOWN;
 	priv->concheck_x[1].state = NM_CONNECTIVITY_UNKNOWN;
@@ -17463,7 +17845,7 @@ dispose (GObject *object)
 
 	nm_clear_g_source (&priv->check_delete_unrealized_id);
 
-	nm_clear_g_source (&priv->stats.timeout_id);
+	_stats_group_detach (self);
 
 	carrier_disconnected_action_cancel (self);
 
@@ -17489,6 +17871,9 @@ dispose (GObject *object)
 	nm_clear_g_source (&priv->device_link_changed_id);
 	nm_clear_g_source (&priv->device_ip_link_changed_id);
 
+	_queued_ip_config_clear (self, AF_INET);
+	_queued_ip_config_clear (self, AF_INET6);
+
 	if (priv->lldp_listener) {
 		g_signal_handlers_disconnect_by_func (priv->lldp_listener,
 		                                      G_CALLBACK (lldp_neighbors_changed),
@@ -17636,6 +18021,7 @@ static const NMDBusInterfaceInfoExtended interface_info_device = {
 			NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE       ("Ip4Connectivity",      "u",      NM_DEVICE_IP4_CONNECTIVITY),
 			NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE       ("Ip6Connectivity",      "u",      NM_DEVICE_IP6_CONNECTIVITY),
 			NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE       ("InterfaceFlags",       "u",      NM_DEVICE_INTERFACE_FLAGS),
+			NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE       ("ActivationTimeline",   "a(su)",  NM_DEVICE_ACTIVATION_TIMELINE),
 		),
 	),
 };
@@ -17919,6 +18305,12 @@ nm_device_class_init (NMDeviceClass *klass)
 	                       0,
 	                       G_PARAM_READABLE |
 	                       G_PARAM_STATIC_STRINGS);
+	obj_properties[PROP_ACTIVATION_TIMELINE] =
+	    g_param_spec_variant (NM_DEVICE_ACTIVATION_TIMELINE, "", "",
+	                          G_VARIANT_TYPE ("a(su)"),
+	                          NULL,
+	                          G_PARAM_READABLE |
+	                          G_PARAM_STATIC_STRINGS);
 
 	g_object_class_install_properties (object_class, _PROPERTY_ENUMS_LAST, obj_properties);
 
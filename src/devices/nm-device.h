@@ -134,6 +134,7 @@ nm_device_state_reason_check (NMDeviceStateReason reason)
 #define NM_DEVICE_IP4_CONNECTIVITY           "ip4-connectivity"
 #define NM_DEVICE_IP6_CONNECTIVITY           "ip6-connectivity"
 #define NM_DEVICE_INTERFACE_FLAGS            "interface-flags"
+#define NM_DEVICE_ACTIVATION_TIMELINE        "activation-timeline"
 
 #define NM_TYPE_DEVICE            (nm_device_get_type ())
 #define NM_DEVICE(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), NM_TYPE_DEVICE, NMDevice))
@@ -582,6 +583,12 @@ gboolean nm_device_unmanage_on_quit (NMDevice *self);
 
 gboolean nm_device_spec_match_list (NMDevice *device, const GSList *specs);
 int      nm_device_spec_match_list_full (NMDevice *self, const GSList *specs, int no_match_value);
+int      nm_device_spec_match_compiled_full (NMDevice *self, const NMMatchSpecDevice *match_spec, int no_match_value);
+
+#define NM_DEVICE_SPEC_MATCH_N_VALUES 7
+
+void     nm_device_get_spec_match_values (NMDevice *self,
+                                          const char *out_values[static NM_DEVICE_SPEC_MATCH_N_VALUES]);
 
 gboolean nm_device_is_activating (NMDevice *dev);
 gboolean nm_device_autoconnect_allowed (NMDevice *self);
@@ -769,6 +776,8 @@ void nm_device_queue_state   (NMDevice *self,
                               NMDeviceState state,
                               NMDeviceStateReason reason);
 
+void nm_device_activation_timeline_add (NMDevice *self, const char *event);
+
 gboolean nm_device_get_firmware_missing (NMDevice *self);
 
 void nm_device_disconnect_active_connection (NMActiveConnection *active,
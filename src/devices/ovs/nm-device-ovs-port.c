@@ -71,6 +71,9 @@ add_iface_cb (GError *error, gpointer user_data)
 {
 	NMDevice *slave = user_data;
 
+	if (!error)
+		nm_device_activation_timeline_add (slave, "ovsdb-add-interface");
+
 	if (   error
 	    && !g_error_matches (error, NM_UTILS_ERROR, NM_UTILS_ERROR_CANCELLED_DISPOSING)) {
 		nm_log_warn (LOGD_DEVICE, "device %s could not be added to a ovs port: %s",
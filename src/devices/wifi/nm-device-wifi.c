@@ -2104,6 +2104,7 @@ supplicant_iface_state (NMDeviceWifi *self,
 
 	switch (new_state) {
 	case NM_SUPPLICANT_INTERFACE_STATE_COMPLETED:
+		nm_device_activation_timeline_add (NM_DEVICE (self), "supplicant-completed");
 		nm_clear_g_source (&priv->sup_timeout_id);
 		nm_clear_g_source (&priv->link_timeout_id);
 		nm_clear_g_source (&priv->wps_timeout_id);
@@ -889,6 +889,7 @@ static const NMDBusInterfaceInfoExtended interface_info_access_point = {
 		),
 	),
 	.legacy_property_changed = TRUE,
+	.high_volume = TRUE,
 };
 
 static void
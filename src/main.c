@@ -35,6 +35,7 @@
 #include "dns/nm-dns-manager.h"
 #include "systemd/nm-sd.h"
 #include "nm-netns.h"
+#include "nm-libnm-core-intern/nm-common-macros.h"
 
 #if !defined(NM_DIST_VERSION)
 # define NM_DIST_VERSION VERSION
@@ -422,10 +423,24 @@ main (int argc, char *argv[])
 
 	manager = nm_manager_setup ();
 
+	nm_dbus_manager_set_filter_signals (nm_dbus_manager_get (),
+	                                    nm_config_data_get_value_boolean (nm_config_get_data_orig (config),
+	                                                                      NM_CONFIG_KEYFILE_GROUP_MAIN,
+	                                                                      NM_CONFIG_KEYFILE_KEY_MAIN_FILTER_DBUS_SIGNALS,
+	                                                                      FALSE));
+
 	nm_dbus_manager_start (nm_dbus_manager_get(),
 	                       nm_manager_dbus_set_property_handle,
 	                       manager);
 
+	if (nm_config_data_get_value_boolean (nm_config_get_data_orig (config),
+	                                      NM_CONFIG_KEYFILE_GROUP_MAIN,
+	                                      NM_CONFIG_KEYFILE_KEY_MAIN_PRIVATE_CLIENT_SOCKET,
+	                                      FALSE)) {
+		nm_dbus_manager_private_client_server_register (nm_dbus_manager_get (),
+		                                                NM_DBUS_PRIVATE_CLIENT_SOCKET);
+	}
+
 	g_signal_connect (manager, NM_MANAGER_CONFIGURE_QUIT, G_CALLBACK (manager_configure_quit), config);
 
 	if (!nm_manager_start (manager, &error)) {
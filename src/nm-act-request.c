@@ -75,6 +75,18 @@ nm_act_request_get_applied_connection (NMActRequest *req)
 
 /*****************************************************************************/
 
+static void
+_timeline_add (NMActRequest *self, const char *event)
+{
+	NMDevice *device;
+
+	device = nm_active_connection_get_device (NM_ACTIVE_CONNECTION (self));
+	if (device)
+		nm_device_activation_timeline_add (device, event);
+}
+
+/*****************************************************************************/
+
 struct _NMActRequestGetSecretsCallId {
 	CList call_ids_lst;
 	NMActRequest *self;
@@ -118,6 +130,8 @@ get_secrets_cb (NMSettingsConnection *connection,
 
 	c_list_unlink (&call_id->call_ids_lst);
 
+	_timeline_add (call_id->self, error ? "secrets-failed" : "secrets");
+
 	if (call_id->callback)
 		call_id->callback (call_id->self, call_id, connection, error, call_id->callback_data);
 
@@ -177,6 +191,8 @@ nm_act_request_get_secrets (NMActRequest *self,
 	if (nm_active_connection_get_user_requested (NM_ACTIVE_CONNECTION (self)))
 		flags |= NM_SECRET_AGENT_GET_SECRETS_FLAG_USER_REQUESTED;
 
+	_timeline_add (self, "secrets-request");
+
 	call_id_s = nm_settings_connection_get_secrets (settings_connection,
 	                                                applied_connection,
 	                                                nm_active_connection_get_subject (NM_ACTIVE_CONNECTION (self)),
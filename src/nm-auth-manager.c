@@ -21,6 +21,10 @@
 #define CANCELLATION_ID_PREFIX "cancellation-id-"
 #define CANCELLATION_TIMEOUT_MS 5000
 
+/* how long we reuse a decision of polkit for the same subject and action. */
+#define AUTH_CACHE_TTL_MSEC     5000
+#define AUTH_CACHE_MAX_SIZE     256
+
 /*****************************************************************************/
 
 NM_GOBJECT_PROPERTIES_DEFINE_BASE (
@@ -34,10 +38,24 @@ enum {
 
 static guint signals[LAST_SIGNAL] = {0};
 
+typedef struct {
+	gint64 expiry_msec;
+	bool is_authorized:1;
+	char key[];
+} AuthCacheEntry;
+
 typedef struct {
 	CList calls_lst_head;
 	GDBusConnection *dbus_connection;
 	GCancellable *shutdown_cancellable;
+
+	/* recent decisions of polkit, by _auth_cache_key(). */
+	GHashTable *auth_cache;
+	guint64 auth_cache_generation;
+	guint auth_cache_ttl_msec;
+	guint auth_cache_hits;
+	guint auth_cache_misses;
+
 	guint64 call_numid_counter;
 	guint changed_signal_id;
 	bool disposing:1;
@@ -117,6 +135,8 @@ struct _NMAuthManagerCallId {
 	NMAuthManagerCheckAuthorizationCallback callback;
 	gpointer user_data;
 	guint64 call_numid;
+	char *auth_cache_key;
+	guint64 auth_cache_generation;
 	guint idle_id;
 	bool idle_is_authorized:1;
 };
@@ -139,10 +159,112 @@ _call_id_free (NMAuthManagerCallId *call_id)
 		return;
 	}
 
+	g_free (call_id->auth_cache_key);
 	g_object_unref (call_id->self);
 	g_slice_free (NMAuthManagerCallId, call_id);
 }
 
+/*****************************************************************************/
+
+static char *
+_auth_cache_key (NMAuthSubject *subject,
+                 const char *action_id)
+{
+	char subject_buf[100];
+
+	return g_strdup_printf ("%s/%s",
+	                        nm_auth_subject_to_string (subject, subject_buf, sizeof (subject_buf)),
+	                        action_id);
+}
+
+static void
+_auth_cache_log_stats (NMAuthManager *self)
+{
+	NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE (self);
+	guint total = priv->auth_cache_hits + priv->auth_cache_misses;
+
+	_LOGD ("cache: %u hits, %u misses (%u%% hit rate)",
+	       priv->auth_cache_hits,
+	       priv->auth_cache_misses,
+	       total > 0 ? (guint) ((100u * (guint64) priv->auth_cache_hits) / total) : 0u);
+}
+
+static void
+_auth_cache_clear (NMAuthManager *self)
+{
+	NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE (self);
+
+	/* pending requests might have been answered before the change.
+	 * Don't cache their result. */
+	priv->auth_cache_generation++;
+
+	if (   priv->auth_cache
+	    && g_hash_table_size (priv->auth_cache) > 0) {
+		_LOGT ("cache: drop %u entries", g_hash_table_size (priv->auth_cache));
+		g_hash_table_remove_all (priv->auth_cache);
+	}
+}
+
+static const AuthCacheEntry *
+_auth_cache_lookup (NMAuthManager *self,
+                    const char *key)
+{
+	NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE (self);
+	AuthCacheEntry *entry;
+
+	entry = g_hash_table_lookup (priv->auth_cache, key);
+	if (   entry
+	    && entry->expiry_msec <= nm_utils_get_monotonic_timestamp_msec ()) {
+		g_hash_table_remove (priv->auth_cache, key);
+		entry = NULL;
+	}
+
+	if (entry)
+		priv->auth_cache_hits++;
+	else
+		priv->auth_cache_misses++;
+
+	if (   (priv->auth_cache_hits + priv->auth_cache_misses) % 100u == 0
+	    && _LOGD_ENABLED ())
+		_auth_cache_log_stats (self);
+
+	return entry;
+}
+
+static void
+_auth_cache_add (NMAuthManager *self,
+                 const char *key,
+                 gboolean is_authorized)
+{
+	NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE (self);
+	AuthCacheEntry *entry;
+	gint64 now_msec;
+	gsize l;
+
+	now_msec = nm_utils_get_monotonic_timestamp_msec ();
+
+	if (g_hash_table_size (priv->auth_cache) >= AUTH_CACHE_MAX_SIZE) {
+		GHashTableIter iter;
+
+		g_hash_table_iter_init (&iter, priv->auth_cache);
+		while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &entry)) {
+			if (entry->expiry_msec <= now_msec)
+				g_hash_table_iter_remove (&iter);
+		}
+		if (g_hash_table_size (priv->auth_cache) >= AUTH_CACHE_MAX_SIZE)
+			g_hash_table_remove_all (priv->auth_cache);
+	}
+
+	l = strlen (key) + 1;
+	entry = g_malloc (sizeof (AuthCacheEntry) + l);
+	entry->expiry_msec = now_msec + priv->auth_cache_ttl_msec;
+	entry->is_authorized = is_authorized;
+	memcpy (entry->key, key, l);
+	g_hash_table_insert (priv->auth_cache, entry->key, entry);
+}
+
+/*****************************************************************************/
+
 static void
 _call_id_invoke_callback (NMAuthManagerCallId *call_id,
                           gboolean is_authorized,
@@ -247,6 +369,14 @@ _call_check_authorize_cb (GObject *proxy,
 		               NULL);
 		_LOG2T (call_id, "completed: authorized=%d, challenge=%d",
 		        is_authorized, is_challenge);
+
+		/* a challenge means that the user could still authenticate. Only
+		 * remember definite answers. */
+		if (   !is_challenge
+		    && call_id->auth_cache_key
+		    && priv->auth_cache
+		    && call_id->auth_cache_generation == priv->auth_cache_generation)
+			_auth_cache_add (self, call_id->auth_cache_key, is_authorized);
 	} else
 		_LOG2T (call_id, "completed: failed: %s", error->message);
 
@@ -338,6 +468,29 @@ nm_auth_manager_check_authorization (NMAuthManager *self,
 		GVariantBuilder builder;
 		GVariant *subject_value;
 		GVariant *details_value;
+		const AuthCacheEntry *entry;
+		gs_free char *auth_cache_key = NULL;
+
+		/* a non-interactive answer is also valid for an interactive request:
+		 * either the subject is authorized anyway, or it cannot become
+		 * authorized (a challenge is never cached). */
+		auth_cache_key = _auth_cache_key (subject, action_id);
+		entry = _auth_cache_lookup (self, auth_cache_key);
+		if (entry) {
+			_LOG2T (call_id, "CheckAuthorization(%s), subject=%s (cached %s)", action_id, nm_auth_subject_to_string (subject, subject_buf, sizeof (subject_buf)),
+			        entry->is_authorized ? "grant" : "deny");
+			call_id->idle_is_authorized = entry->is_authorized;
+			call_id->idle_id = g_idle_add (_call_on_idle, call_id);
+			return call_id;
+		}
+
+		/* but an interactive grant might be a one-time authentication of
+		 * the user, that must not be reused. Only remember the answers to
+		 * non-interactive requests. */
+		if (flags == POLKIT_CHECK_AUTHORIZATION_FLAGS_NONE) {
+			call_id->auth_cache_key = g_steal_pointer (&auth_cache_key);
+			call_id->auth_cache_generation = priv->auth_cache_generation;
+		}
 
 		subject_value = nm_auth_subject_unix_to_polkit_gvariant (subject);
 		nm_assert (g_variant_is_floating (subject_value));
@@ -413,6 +566,7 @@ changed_signal_cb (GDBusConnection *connection,
 	NMAuthManager *self = user_data;
 
 	_LOGD ("dbus signal: \"Changed\"");
+	_auth_cache_clear (self);
 	g_signal_emit (self, signals[CHANGED_SIGNAL], 0);
 }
 
@@ -426,6 +580,14 @@ nm_auth_manager_get ()
 	return singleton_instance;
 }
 
+void
+nmtst_auth_manager_set_cache_ttl (NMAuthManager *self, guint ttl_msec)
+{
+	g_return_if_fail (NM_IS_AUTH_MANAGER (self));
+
+	NM_AUTH_MANAGER_GET_PRIVATE (self)->auth_cache_ttl_msec = ttl_msec;
+}
+
 void
 nm_auth_manager_force_shutdown (NMAuthManager *self)
 {
@@ -493,6 +655,7 @@ nm_auth_manager_init (NMAuthManager *self)
 
 	c_list_init (&priv->calls_lst_head);
 	priv->auth_polkit_mode = NM_AUTH_POLKIT_MODE_ROOT_ONLY;
+	priv->auth_cache_ttl_msec = AUTH_CACHE_TTL_MSEC;
 }
 
 static void
@@ -525,6 +688,8 @@ constructed (GObject *object)
 
 	priv->shutdown_cancellable = g_cancellable_new ();
 
+	priv->auth_cache = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
+
 	priv->changed_signal_id = g_dbus_connection_signal_subscribe (priv->dbus_connection,
 	                                                              POLKIT_SERVICE,
 	                                                              POLKIT_INTERFACE,
@@ -583,6 +748,11 @@ dispose (GObject *object)
 	nm_clear_g_dbus_connection_signal (priv->dbus_connection,
 	                                   &priv->changed_signal_id);
 
+	if (priv->auth_cache) {
+		_auth_cache_log_stats (self);
+		nm_clear_pointer (&priv->auth_cache, g_hash_table_destroy);
+	}
+
 	G_OBJECT_CLASS (nm_auth_manager_parent_class)->dispose (object);
 
 	g_clear_object (&priv->dbus_connection);
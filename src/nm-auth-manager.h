@@ -83,4 +83,7 @@ NMAuthManagerCallId *nm_auth_manager_check_authorization (NMAuthManager *self,
 
 void nm_auth_manager_check_authorization_cancel (NMAuthManagerCallId *call_id);
 
+/* For testing only */
+void nmtst_auth_manager_set_cache_ttl (NMAuthManager *self, guint ttl_msec);
+
 #endif /* NM_AUTH_MANAGER_H */
@@ -8,6 +8,7 @@
 
 #include "nm-config-data.h"
 
+#include "nm-glib-aux/nm-c-list.h"
 #include "nm-config.h"
 #include "devices/nm-device.h"
 #include "nm-core-internal.h"
@@ -23,7 +24,7 @@ typedef struct {
 		 * value %NULL does not necessarily mean, that the property
 		 * "match-device" was unspecified. */
 		gboolean has;
-		GSList *spec;
+		NMMatchSpecDevice *spec;
 	} match_device;
 } MatchSectionInfo;
 
@@ -71,6 +72,12 @@ typedef struct {
 	 * [device] sections. This is to speed up lookup. */
 	MatchSectionInfo *device_infos;
 
+	/* Caches the lookup results from the [device] and [connection] sections.
+	 * A set of DeviceCacheEntry, keyed by nm_device_get_spec_match_values().
+	 * The entries are also tracked in least-recently-used order. */
+	GHashTable *device_cache;
+	CList device_cache_lru_lst_head;
+
 	struct {
 		gboolean enabled;
 		char *uri;
@@ -90,8 +97,8 @@ typedef struct {
 		GSList *specs_config;
 	} no_auto_default;
 
-	GSList *ignore_carrier;
-	GSList *assume_ipv6ll_only;
+	NMMatchSpecDevice *ignore_carrier;
+	NMMatchSpecDevice *assume_ipv6ll_only;
 
 	char *dns_mode;
 	char *rc_manager;
@@ -332,7 +339,7 @@ nm_config_data_get_ignore_carrier (const NMConfigData *self, NMDevice *device)
 	if (has_match)
 		m = nm_config_parse_boolean (value, -1);
 	else
-		m = nm_device_spec_match_list_full (device, NM_CONFIG_DATA_GET_PRIVATE (self)->ignore_carrier, -1);
+		m = nm_device_spec_match_compiled_full (device, NM_CONFIG_DATA_GET_PRIVATE (self)->ignore_carrier, -1);
 
 	if (NM_IN_SET (m, TRUE, FALSE))
 		return m;
@@ -347,7 +354,7 @@ nm_config_data_get_assume_ipv6ll_only (const NMConfigData *self, NMDevice *devic
 	g_return_val_if_fail (NM_IS_CONFIG_DATA (self), FALSE);
 	g_return_val_if_fail (NM_IS_DEVICE (device), FALSE);
 
-	return nm_device_spec_match_list (device, NM_CONFIG_DATA_GET_PRIVATE (self)->assume_ipv6ll_only);
+	return nm_device_spec_match_compiled_full (device, NM_CONFIG_DATA_GET_PRIVATE (self)->assume_ipv6ll_only, FALSE);
 }
 
 GKeyFile *
@@ -1339,7 +1346,7 @@ _match_section_infos_lookup (const MatchSectionInfo *match_section_infos,
 
 		if (match_section_infos->match_device.has) {
 			if (device)
-				match = nm_device_spec_match_list (device, match_section_infos->match_device.spec);
+				match = nm_device_spec_match_compiled_full (device, match_section_infos->match_device.spec, FALSE);
 			else if (pllink)
 				match = nm_match_spec_device_by_pllink (pllink, match_device_type, match_dhcp_plugin, match_section_infos->match_device.spec, FALSE);
 			else
@@ -1356,6 +1363,163 @@ _match_section_infos_lookup (const MatchSectionInfo *match_section_infos,
 	return NULL;
 }
 
+/*****************************************************************************/
+
+/* With an unchanged configuration, entries only become stale when devices
+ * change. When the cache is full, the least recently used entry is evicted. */
+#define DEVICE_CACHE_MAX 1024
+
+typedef struct {
+	char *value;
+	bool has_match:1;
+} CachedValue;
+
+typedef struct {
+	CList lru_lst;
+	guint hash;
+	const char *match_values[NM_DEVICE_SPEC_MATCH_N_VALUES];
+	/* the lookup results for the [device] and [connection] sections,
+	 * by property name. */
+	GHashTable *values[2];
+} DeviceCacheEntry;
+
+static void
+_cached_value_free (gpointer data)
+{
+	CachedValue *cv = data;
+
+	g_free (cv->value);
+	g_slice_free (CachedValue, cv);
+}
+
+static guint
+_device_cache_entry_hash (gconstpointer data)
+{
+	return ((const DeviceCacheEntry *) data)->hash;
+}
+
+static gboolean
+_device_cache_entry_equal (gconstpointer a, gconstpointer b)
+{
+	const DeviceCacheEntry *entry_a = a;
+	const DeviceCacheEntry *entry_b = b;
+	guint i;
+
+	if (entry_a->hash != entry_b->hash)
+		return FALSE;
+	for (i = 0; i < NM_DEVICE_SPEC_MATCH_N_VALUES; i++) {
+		if (!nm_streq0 (entry_a->match_values[i], entry_b->match_values[i]))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static void
+_device_cache_entry_free (gpointer data)
+{
+	DeviceCacheEntry *entry = data;
+	guint i;
+
+	c_list_unlink_stale (&entry->lru_lst);
+	for (i = 0; i < NM_DEVICE_SPEC_MATCH_N_VALUES; i++)
+		g_free ((char *) entry->match_values[i]);
+	if (entry->values[0])
+		g_hash_table_unref (entry->values[0]);
+	if (entry->values[1])
+		g_hash_table_unref (entry->values[1]);
+	g_slice_free (DeviceCacheEntry, entry);
+}
+
+static DeviceCacheEntry *
+_device_cache_get_entry (NMConfigDataPrivate *priv,
+                         NMDevice *device)
+{
+	DeviceCacheEntry needle;
+	DeviceCacheEntry *entry;
+	NMHashState h;
+	guint i;
+
+	/* the needle only borrows the strings from @device, so that a cache
+	 * hit does not allocate. */
+	nm_device_get_spec_match_values (device, needle.match_values);
+	nm_hash_init (&h, 1490637419u);
+	for (i = 0; i < NM_DEVICE_SPEC_MATCH_N_VALUES; i++)
+		nm_hash_update_str0 (&h, needle.match_values[i]);
+	needle.hash = nm_hash_complete (&h);
+
+	if (!priv->device_cache) {
+		priv->device_cache = g_hash_table_new_full (_device_cache_entry_hash,
+		                                            _device_cache_entry_equal,
+		                                            _device_cache_entry_free,
+		                                            NULL);
+		c_list_init (&priv->device_cache_lru_lst_head);
+	}
+
+	entry = g_hash_table_lookup (priv->device_cache, &needle);
+	if (entry) {
+		nm_c_list_move_tail (&priv->device_cache_lru_lst_head, &entry->lru_lst);
+		return entry;
+	}
+
+	if (g_hash_table_size (priv->device_cache) >= DEVICE_CACHE_MAX) {
+		g_hash_table_remove (priv->device_cache,
+		                     c_list_first_entry (&priv->device_cache_lru_lst_head, DeviceCacheEntry, lru_lst));
+	}
+
+	entry = g_slice_new0 (DeviceCacheEntry);
+	entry->hash = needle.hash;
+	for (i = 0; i < NM_DEVICE_SPEC_MATCH_N_VALUES; i++)
+		entry->match_values[i] = g_strdup (needle.match_values[i]);
+	c_list_link_tail (&priv->device_cache_lru_lst_head, &entry->lru_lst);
+	g_hash_table_add (priv->device_cache, entry);
+	return entry;
+}
+
+/* Like _match_section_infos_lookup() for a @device, but remembers the
+ * result. The result only depends on the configuration (which is immutable)
+ * and on the properties of the device that are used for matching. */
+static char *
+_match_section_infos_lookup_cached (const NMConfigData *self,
+                                    gboolean is_device_infos,
+                                    const char *property,
+                                    NMDevice *device,
+                                    gboolean *out_has_match)
+{
+	NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE ((NMConfigData *) self);
+	DeviceCacheEntry *entry;
+	GHashTable **p_values;
+	CachedValue *cv;
+
+	nm_assert (NM_IS_DEVICE (device));
+
+	entry = _device_cache_get_entry (priv, device);
+
+	p_values = &entry->values[is_device_infos ? 0 : 1];
+	if (!*p_values)
+		*p_values = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, _cached_value_free);
+
+	cv = g_hash_table_lookup (*p_values, property);
+	if (!cv) {
+		char *value = NULL;
+
+		cv = g_slice_new (CachedValue);
+		cv->has_match = !!_match_section_infos_lookup (  is_device_infos
+		                                               ? &priv->device_infos[0]
+		                                               : &priv->connection_infos[0],
+		                                               priv->keyfile,
+		                                               property,
+		                                               device,
+		                                               NULL,
+		                                               NULL,
+		                                               &value);
+		cv->value = value;
+		g_hash_table_insert (*p_values, g_strdup (property), cv);
+	}
+
+	NM_SET_OUT (out_has_match, cv->has_match);
+	return g_strdup (cv->value);
+}
+
 char *
 nm_config_data_get_device_config (const NMConfigData *self,
                                   const char *property,
@@ -1369,6 +1533,9 @@ nm_config_data_get_device_config (const NMConfigData *self,
 	g_return_val_if_fail (self, NULL);
 	g_return_val_if_fail (property && *property, NULL);
 
+	if (device)
+		return _match_section_infos_lookup_cached (self, TRUE, property, device, has_match);
+
 	priv = NM_CONFIG_DATA_GET_PRIVATE (self);
 
 	connection_info = _match_section_infos_lookup (&priv->device_infos[0],
@@ -1452,6 +1619,9 @@ nm_config_data_get_connection_default (const NMConfigData *self,
 	}
 #endif
 
+	if (device)
+		return _match_section_infos_lookup_cached (self, FALSE, property, device, NULL);
+
 	_match_section_infos_lookup (&priv->connection_infos[0],
 	                             priv->keyfile,
 	                             property,
@@ -1479,13 +1649,19 @@ nm_config_data_get_connection_default_int64 (const NMConfigData *self,
 static void
 _get_connection_info_init (MatchSectionInfo *connection_info, GKeyFile *keyfile, char *group)
 {
+	GSList *specs;
+
 	/* pass ownership of @group on... */
 	connection_info->group_name = group;
 
-	connection_info->match_device.spec = nm_config_get_match_spec (keyfile,
-	                                                               group,
-	                                                               NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE,
-	                                                               &connection_info->match_device.has);
+	/* the specs are compiled once, instead of being parsed on every lookup. */
+	specs = nm_config_get_match_spec (keyfile,
+	                                  group,
+	                                  NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE,
+	                                  &connection_info->match_device.has);
+	if (connection_info->match_device.has)
+		connection_info->match_device.spec = nm_match_spec_device_new (specs);
+	g_slist_free_full (specs, g_free);
 	connection_info->stop_match = nm_config_keyfile_get_boolean (keyfile,
 	                                                             group,
 	                                                             NM_CONFIG_KEYFILE_KEY_STOP_MATCH,
@@ -1501,7 +1677,7 @@ _match_section_infos_free (MatchSectionInfo *match_section_infos)
 		return;
 	for (i = 0; match_section_infos[i].group_name; i++) {
 		g_free (match_section_infos[i].group_name);
-		g_slist_free_full (match_section_infos[i].match_device.spec, g_free);
+		nm_match_spec_device_free (match_section_infos[i].match_device.spec);
 	}
 	g_free (match_section_infos);
 }
@@ -1760,6 +1936,7 @@ constructed (GObject *object)
 {
 	NMConfigData *self = NM_CONFIG_DATA (object);
 	NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE (self);
+	GSList *specs;
 	char *str;
 
 	priv->keyfile = _merge_keyfiles (priv->keyfile_user, priv->keyfile_intern);
@@ -1807,14 +1984,22 @@ constructed (GObject *object)
 	                                                        NM_CONFIG_KEYFILE_GROUP_MAIN,
 	                                                        NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED,
 	                                                        TRUE);
-	priv->ignore_carrier = nm_config_get_match_spec (priv->keyfile,
-	                                                 NM_CONFIG_KEYFILE_GROUP_MAIN,
-	                                                 NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
-	                                                 NULL);
-	priv->assume_ipv6ll_only = nm_config_get_match_spec (priv->keyfile,
-	                                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
-	                                                     NM_CONFIG_KEYFILE_KEY_MAIN_ASSUME_IPV6LL_ONLY,
-	                                                     NULL);
+	specs = nm_config_get_match_spec (priv->keyfile,
+	                                  NM_CONFIG_KEYFILE_GROUP_MAIN,
+	                                  NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
+	                                  NULL);
+	if (specs) {
+		priv->ignore_carrier = nm_match_spec_device_new (specs);
+		g_slist_free_full (specs, g_free);
+	}
+	specs = nm_config_get_match_spec (priv->keyfile,
+	                                  NM_CONFIG_KEYFILE_GROUP_MAIN,
+	                                  NM_CONFIG_KEYFILE_KEY_MAIN_ASSUME_IPV6LL_ONLY,
+	                                  NULL);
+	if (specs) {
+		priv->assume_ipv6ll_only = nm_match_spec_device_new (specs);
+		g_slist_free_full (specs, g_free);
+	}
 	priv->no_auto_default.specs_config = nm_config_get_match_spec (priv->keyfile,
 	                                                               NM_CONFIG_KEYFILE_GROUP_MAIN,
 	                                                               NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT,
@@ -1890,13 +2075,14 @@ finalize (GObject *gobject)
 	g_free (priv->dns_mode);
 	g_free (priv->rc_manager);
 
-	g_slist_free_full (priv->ignore_carrier, g_free);
-	g_slist_free_full (priv->assume_ipv6ll_only, g_free);
+	nm_match_spec_device_free (priv->ignore_carrier);
+	nm_match_spec_device_free (priv->assume_ipv6ll_only);
 
 	nm_global_dns_config_free (priv->global_dns);
 
 	_match_section_infos_free (priv->connection_infos);
 	_match_section_infos_free (priv->device_infos);
+	nm_clear_pointer (&priv->device_cache, g_hash_table_unref);
 
 	g_key_file_unref (priv->keyfile);
 	if (priv->keyfile_user)
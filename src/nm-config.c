@@ -766,12 +766,15 @@ static const ConfigGroup config_groups[] = {
 			NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG,
 			NM_CONFIG_KEYFILE_KEY_MAIN_DHCP,
 			NM_CONFIG_KEYFILE_KEY_MAIN_DNS,
+			NM_CONFIG_KEYFILE_KEY_MAIN_FILTER_DBUS_SIGNALS,
 			NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE,
 			NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
 			NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES,
 			NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT,
 			NM_CONFIG_KEYFILE_KEY_MAIN_PLUGINS,
+			NM_CONFIG_KEYFILE_KEY_MAIN_PRIVATE_CLIENT_SOCKET,
 			NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER,
+			NM_CONFIG_KEYFILE_KEY_MAIN_SETTINGS_DURABILITY,
 			NM_CONFIG_KEYFILE_KEY_MAIN_SLAVES_ORDER,
 			NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED,
 		),
@@ -798,6 +801,7 @@ static const ConfigGroup config_groups[] = {
 		.group = NM_CONFIG_KEYFILE_GROUP_KEYFILE,
 		.keys = NM_MAKE_STRV (
 			NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME,
+			NM_CONFIG_KEYFILE_KEY_KEYFILE_MONITOR_CONNECTION_FILES,
 			NM_CONFIG_KEYFILE_KEY_KEYFILE_PATH,
 			NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES,
 		),
@@ -2263,7 +2267,7 @@ _config_device_state_data_new (int ifindex, GKeyFile *kf)
 	if (route_metric_default_effective) {
 		route_metric_default_aspired = nm_config_keyfile_get_int64 (kf,
 		                                                            DEVICE_RUN_STATE_KEYFILE_GROUP_DEVICE,
-		                                                            DEVICE_RUN_STATE_KEYFILE_KEY_DEVICE_ROUTE_METRIC_DEFAULT_EFFECTIVE,
+		                                                            DEVICE_RUN_STATE_KEYFILE_KEY_DEVICE_ROUTE_METRIC_DEFAULT_ASPIRED,
 		                                                            10, 1, route_metric_default_effective,
 		                                                            route_metric_default_effective);
 	} else
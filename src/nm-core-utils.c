@@ -1140,12 +1140,36 @@ match_device_s390_subchannels_parse (const char *s390_subchannels, guint32 *out_
 	return TRUE;
 }
 
-static gboolean
-match_data_s390_subchannels_eval (const char *spec_str,
-                                  MatchDeviceData *match_data)
+static void
+match_device_data_init (MatchDeviceData *match_data,
+                        const char *interface_name,
+                        const char *device_type,
+                        const char *driver,
+                        const char *driver_version,
+                        const char *hwaddr,
+                        const char *s390_subchannels,
+                        const char *dhcp_plugin)
 {
-	guint32 a, b, c;
+	nm_assert (!hwaddr || nm_utils_hwaddr_valid (hwaddr, -1));
 
+	*match_data = (MatchDeviceData) {
+	    .interface_name = interface_name,
+	    .device_type = nm_str_not_empty (device_type),
+	    .driver = nm_str_not_empty (driver),
+	    .driver_version = nm_str_not_empty (driver_version),
+	    .dhcp_plugin = nm_str_not_empty (dhcp_plugin),
+	    .hwaddr = {
+	        .value = hwaddr,
+	    },
+	    .s390_subchannels = {
+	        .value = s390_subchannels,
+	    },
+	};
+}
+
+static gboolean
+match_data_s390_subchannels_ensure (MatchDeviceData *match_data)
+{
 	if (G_UNLIKELY (!match_data->s390_subchannels.is_parsed)) {
 		match_data->s390_subchannels.is_parsed = TRUE;
 
@@ -1157,7 +1181,18 @@ match_data_s390_subchannels_eval (const char *spec_str,
 			match_data->s390_subchannels.value = NULL;
 			return FALSE;
 		}
-	} else if (!match_data->s390_subchannels.value)
+	}
+
+	return !!match_data->s390_subchannels.value;
+}
+
+static gboolean
+match_data_s390_subchannels_eval (const char *spec_str,
+                                  MatchDeviceData *match_data)
+{
+	guint32 a, b, c;
+
+	if (!match_data_s390_subchannels_ensure (match_data))
 		return FALSE;
 
 	if (!match_device_s390_subchannels_parse (spec_str, &a, &b, &c))
@@ -1168,8 +1203,7 @@ match_data_s390_subchannels_eval (const char *spec_str,
 }
 
 static gboolean
-match_device_hwaddr_eval (const char *spec_str,
-                          MatchDeviceData *match_data)
+match_data_hwaddr_ensure (MatchDeviceData *match_data)
 {
 	if (G_UNLIKELY (!match_data->hwaddr.is_parsed)) {
 		match_data->hwaddr.is_parsed = TRUE;
@@ -1180,9 +1214,17 @@ match_device_hwaddr_eval (const char *spec_str,
 			if (!_nm_utils_hwaddr_aton (match_data->hwaddr.value, match_data->hwaddr.bin, sizeof (match_data->hwaddr.bin), &l))
 				g_return_val_if_reached (FALSE);
 			match_data->hwaddr.len = l;
-		} else
-			return FALSE;
-	} else if (!match_data->hwaddr.len)
+		}
+	}
+
+	return match_data->hwaddr.len > 0;
+}
+
+static gboolean
+match_device_hwaddr_eval (const char *spec_str,
+                          MatchDeviceData *match_data)
+{
+	if (!match_data_hwaddr_ensure (match_data))
 		return FALSE;
 
 	return nm_utils_hwaddr_matches (spec_str, -1, match_data->hwaddr.bin, match_data->hwaddr.len);
@@ -1338,25 +1380,20 @@ nm_match_spec_device (const GSList *specs,
 	gboolean has_except = FALSE;
 	gboolean has_not_except = FALSE;
 	const char *spec_str;
-	MatchDeviceData match_data = {
-	    .interface_name = interface_name,
-	    .device_type = nm_str_not_empty (device_type),
-	    .driver = nm_str_not_empty (driver),
-	    .driver_version = nm_str_not_empty (driver_version),
-	    .dhcp_plugin = nm_str_not_empty (dhcp_plugin),
-	    .hwaddr = {
-	        .value = hwaddr,
-	    },
-	    .s390_subchannels = {
-	        .value = s390_subchannels,
-	    },
-	};
-
-	nm_assert (!hwaddr || nm_utils_hwaddr_valid (hwaddr, -1));
+	MatchDeviceData match_data;
 
 	if (!specs)
 		return NM_MATCH_SPEC_NO_MATCH;
 
+	match_device_data_init (&match_data,
+	                        interface_name,
+	                        device_type,
+	                        driver,
+	                        driver_version,
+	                        hwaddr,
+	                        s390_subchannels,
+	                        dhcp_plugin);
+
 	for (iter = specs; iter; iter = iter->next) {
 		gboolean except;
 
@@ -1392,6 +1429,346 @@ nm_match_spec_device (const GSList *specs,
 	return _match_result (has_except, has_not_except, has_match, has_match_except);
 }
 
+/*****************************************************************************/
+
+typedef struct {
+	char *driver;
+	gsize driver_len;
+	GPatternSpec *version;
+} MatchSpecDriverVersion;
+
+typedef struct {
+	guint32 a;
+	guint32 b;
+	guint32 c;
+} MatchSpecS390Subchannels;
+
+typedef struct {
+	GHashTable *interface_names;
+	GPtrArray *interface_patterns;
+	GHashTable *device_types;
+	GHashTable *hwaddrs;
+	GHashTable *drivers;
+	GArray *driver_versions;
+	GArray *s390_subchannels;
+	GHashTable *dhcp_plugins;
+	bool match_all:1;
+} MatchSpecGroup;
+
+struct _NMMatchSpecDevice {
+	/* the specs without and with "except:" prefix. */
+	MatchSpecGroup groups[2];
+	bool has_except:1;
+	bool has_not_except:1;
+};
+
+#define MATCH_SPEC_HWADDR_KEY_LEN (1 + 2 * NM_UTILS_HWADDR_LEN_MAX + 1)
+
+static const char *
+_match_spec_hwaddr_key (const guint8 *bin, gsize len, char *buf)
+{
+	nm_assert (len > 0 && len <= NM_UTILS_HWADDR_LEN_MAX);
+
+	/* addresses of different length never match. And like for
+	 * nm_utils_hwaddr_matches(), only the last 8 bytes of an
+	 * infiniband address are relevant. */
+	buf[0] = 'a' + len;
+	if (len == INFINIBAND_ALEN) {
+		bin += INFINIBAND_ALEN - 8;
+		len = 8;
+	}
+	nm_utils_bin2hexstr_full (bin, len, '\0', FALSE, &buf[1]);
+	return buf;
+}
+
+static void
+_match_spec_group_add_str (GHashTable **p_hash, const char *str)
+{
+	if (!*p_hash)
+		*p_hash = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_add (*p_hash, g_strdup (str));
+}
+
+static void
+_match_spec_group_add_hwaddr (MatchSpecGroup *group, const char *str)
+{
+	char key[MATCH_SPEC_HWADDR_KEY_LEN];
+	guint8 bin[NM_UTILS_HWADDR_LEN_MAX];
+	gsize len;
+
+	if (!_nm_utils_hwaddr_aton (str, bin, sizeof (bin), &len))
+		return;
+	_match_spec_group_add_str (&group->hwaddrs, _match_spec_hwaddr_key (bin, len, key));
+}
+
+/* this must be kept in sync with match_device_eval(). */
+static void
+_match_spec_group_add (MatchSpecGroup *group,
+                       const char *spec_str,
+                       gboolean allow_fuzzy)
+{
+	if (spec_str[0] == '*' && spec_str[1] == '\0') {
+		group->match_all = TRUE;
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, DEVICE_TYPE_TAG)) {
+		_match_spec_group_add_str (&group->device_types, spec_str);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, NM_MATCH_SPEC_MAC_TAG)) {
+		_match_spec_group_add_hwaddr (group, spec_str);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, NM_MATCH_SPEC_INTERFACE_NAME_TAG)) {
+		gboolean use_pattern = FALSE;
+
+		if (spec_str[0] == '=')
+			spec_str += 1;
+		else {
+			if (spec_str[0] == '~')
+				spec_str += 1;
+			use_pattern = TRUE;
+		}
+
+		/* a pattern without wildcards only matches itself. */
+		if (   use_pattern
+		    && strpbrk (spec_str, "*?")) {
+			if (!group->interface_patterns)
+				group->interface_patterns = g_ptr_array_new_with_free_func ((GDestroyNotify) g_pattern_spec_free);
+			g_ptr_array_add (group->interface_patterns, g_pattern_spec_new (spec_str));
+		} else
+			_match_spec_group_add_str (&group->interface_names, spec_str);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, DRIVER_TAG)) {
+		MatchSpecDriverVersion *dv;
+		const char *t;
+
+		t = strrchr (spec_str, '/');
+		if (!t) {
+			_match_spec_group_add_str (&group->drivers, spec_str);
+			return;
+		}
+
+		if (!group->driver_versions)
+			group->driver_versions = g_array_new (FALSE, FALSE, sizeof (MatchSpecDriverVersion));
+		g_array_set_size (group->driver_versions, group->driver_versions->len + 1);
+		dv = &g_array_index (group->driver_versions, MatchSpecDriverVersion, group->driver_versions->len - 1);
+		dv->driver_len = t - spec_str;
+		dv->driver = g_strndup (spec_str, dv->driver_len);
+		dv->version = g_pattern_spec_new (&t[1]);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, NM_MATCH_SPEC_S390_SUBCHANNELS_TAG)) {
+		MatchSpecS390Subchannels s390;
+
+		if (!match_device_s390_subchannels_parse (spec_str, &s390.a, &s390.b, &s390.c))
+			return;
+		if (!group->s390_subchannels)
+			group->s390_subchannels = g_array_new (FALSE, FALSE, sizeof (MatchSpecS390Subchannels));
+		g_array_append_val (group->s390_subchannels, s390);
+		return;
+	}
+
+	if (_MATCH_CHECK (spec_str, DHCP_PLUGIN_TAG)) {
+		_match_spec_group_add_str (&group->dhcp_plugins, spec_str);
+		return;
+	}
+
+	if (allow_fuzzy) {
+		_match_spec_group_add_hwaddr (group, spec_str);
+		_match_spec_group_add_str (&group->interface_names, spec_str);
+	}
+}
+
+static gboolean
+_match_spec_group_eval (const MatchSpecGroup *group,
+                        MatchDeviceData *match_data)
+{
+	guint i;
+
+	if (group->match_all)
+		return TRUE;
+
+	if (match_data->interface_name) {
+		if (   group->interface_names
+		    && g_hash_table_contains (group->interface_names, match_data->interface_name))
+			return TRUE;
+		if (group->interface_patterns) {
+			for (i = 0; i < group->interface_patterns->len; i++) {
+				if (g_pattern_match_string (group->interface_patterns->pdata[i], match_data->interface_name))
+					return TRUE;
+			}
+		}
+	}
+
+	if (   match_data->device_type
+	    && group->device_types
+	    && g_hash_table_contains (group->device_types, match_data->device_type))
+		return TRUE;
+
+	if (   group->hwaddrs
+	    && match_data_hwaddr_ensure (match_data)) {
+		char key[MATCH_SPEC_HWADDR_KEY_LEN];
+
+		if (g_hash_table_contains (group->hwaddrs,
+		                           _match_spec_hwaddr_key (match_data->hwaddr.bin, match_data->hwaddr.len, key)))
+			return TRUE;
+	}
+
+	if (match_data->driver) {
+		if (   group->drivers
+		    && g_hash_table_contains (group->drivers, match_data->driver))
+			return TRUE;
+		if (group->driver_versions) {
+			for (i = 0; i < group->driver_versions->len; i++) {
+				const MatchSpecDriverVersion *dv = &g_array_index (group->driver_versions, MatchSpecDriverVersion, i);
+
+				if (   strncmp (dv->driver, match_data->driver, dv->driver_len) == 0
+				    && g_pattern_match_string (dv->version, match_data->driver_version ?: ""))
+					return TRUE;
+			}
+		}
+	}
+
+	if (   group->s390_subchannels
+	    && match_data_s390_subchannels_ensure (match_data)) {
+		for (i = 0; i < group->s390_subchannels->len; i++) {
+			const MatchSpecS390Subchannels *s390 = &g_array_index (group->s390_subchannels, MatchSpecS390Subchannels, i);
+
+			if (   s390->a == match_data->s390_subchannels.a
+			    && s390->b == match_data->s390_subchannels.b
+			    && s390->c == match_data->s390_subchannels.c)
+				return TRUE;
+		}
+	}
+
+	if (   match_data->dhcp_plugin
+	    && group->dhcp_plugins
+	    && g_hash_table_contains (group->dhcp_plugins, match_data->dhcp_plugin))
+		return TRUE;
+
+	return FALSE;
+}
+
+static void
+_match_spec_group_clear (MatchSpecGroup *group)
+{
+	guint i;
+
+	nm_clear_pointer (&group->interface_names, g_hash_table_unref);
+	nm_clear_pointer (&group->interface_patterns, g_ptr_array_unref);
+	nm_clear_pointer (&group->device_types, g_hash_table_unref);
+	nm_clear_pointer (&group->hwaddrs, g_hash_table_unref);
+	nm_clear_pointer (&group->drivers, g_hash_table_unref);
+	if (group->driver_versions) {
+		for (i = 0; i < group->driver_versions->len; i++) {
+			MatchSpecDriverVersion *dv = &g_array_index (group->driver_versions, MatchSpecDriverVersion, i);
+
+			g_free (dv->driver);
+			g_pattern_spec_free (dv->version);
+		}
+		nm_clear_pointer (&group->driver_versions, g_array_unref);
+	}
+	nm_clear_pointer (&group->s390_subchannels, g_array_unref);
+	nm_clear_pointer (&group->dhcp_plugins, g_hash_table_unref);
+}
+
+/**
+ * nm_match_spec_device_new:
+ * @specs: the device specs, like for nm_match_spec_device().
+ *
+ * Parses @specs once, so that devices can be matched against them
+ * with nm_match_spec_device_match(). That avoids parsing the specs
+ * over and over, and most specs are looked up in a hash table.
+ *
+ * Returns: (transfer full): the compiled specs. Free with
+ *   nm_match_spec_device_free().
+ */
+NMMatchSpecDevice *
+nm_match_spec_device_new (const GSList *specs)
+{
+	NMMatchSpecDevice *self;
+	const GSList *iter;
+
+	self = g_slice_new0 (NMMatchSpecDevice);
+
+	for (iter = specs; iter; iter = iter->next) {
+		const char *spec_str = iter->data;
+		gboolean except;
+
+		if (!spec_str || !*spec_str)
+			continue;
+
+		spec_str = match_except (spec_str, &except);
+
+		if (except)
+			self->has_except = TRUE;
+		else
+			self->has_not_except = TRUE;
+
+		_match_spec_group_add (&self->groups[except ? 1 : 0],
+		                       spec_str,
+		                       !except);
+	}
+
+	return self;
+}
+
+void
+nm_match_spec_device_free (NMMatchSpecDevice *self)
+{
+	if (!self)
+		return;
+
+	_match_spec_group_clear (&self->groups[0]);
+	_match_spec_group_clear (&self->groups[1]);
+	g_slice_free (NMMatchSpecDevice, self);
+}
+
+/* Gives the same result as nm_match_spec_device() for the specs that
+ * @self was created from. */
+NMMatchSpecMatchType
+nm_match_spec_device_match (const NMMatchSpecDevice *self,
+                            const char *interface_name,
+                            const char *device_type,
+                            const char *driver,
+                            const char *driver_version,
+                            const char *hwaddr,
+                            const char *s390_subchannels,
+                            const char *dhcp_plugin)
+{
+	MatchDeviceData match_data;
+	gboolean has_match;
+	gboolean has_match_except;
+
+	if (!self)
+		return NM_MATCH_SPEC_NO_MATCH;
+
+	match_device_data_init (&match_data,
+	                        interface_name,
+	                        device_type,
+	                        driver,
+	                        driver_version,
+	                        hwaddr,
+	                        s390_subchannels,
+	                        dhcp_plugin);
+
+	has_match =    self->has_not_except
+	            && _match_spec_group_eval (&self->groups[0], &match_data);
+	has_match_except =    self->has_except
+	                   && _match_spec_group_eval (&self->groups[1], &match_data);
+
+	return _match_result (self->has_except, self->has_not_except, has_match, has_match_except);
+}
+
+/*****************************************************************************/
+
 static gboolean
 match_config_eval (const char *str, const char *tag, guint cur_nm_version)
 {
@@ -220,6 +220,20 @@ NMMatchSpecMatchType nm_match_spec_device (const GSList *specs,
                                            const char *hwaddr,
                                            const char *s390_subchannels,
                                            const char *dhcp_plugin);
+
+typedef struct _NMMatchSpecDevice NMMatchSpecDevice;
+
+NMMatchSpecDevice *nm_match_spec_device_new (const GSList *specs);
+void nm_match_spec_device_free (NMMatchSpecDevice *self);
+NMMatchSpecMatchType nm_match_spec_device_match (const NMMatchSpecDevice *self,
+                                                 const char *interface_name,
+                                                 const char *device_type,
+                                                 const char *driver,
+                                                 const char *driver_version,
+                                                 const char *hwaddr,
+                                                 const char *s390_subchannels,
+                                                 const char *dhcp_plugin);
+
 NMMatchSpecMatchType nm_match_spec_config (const GSList *specs,
                                            guint nm_version,
                                            const char *env);
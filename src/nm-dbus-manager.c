@@ -14,6 +14,7 @@
 
 #include "c-list/src/c-list.h"
 #include "nm-glib-aux/nm-c-list.h"
+#include "nm-glib-aux/nm-dbus-aux.h"
 #include "nm-dbus-interface.h"
 #include "nm-core-internal.h"
 #include "nm-std-aux/nm-dbus-compat.h"
@@ -34,21 +35,51 @@ typedef struct {
 	CList caller_info_lst;
 	gulong uid;
 	gulong pid;
-	gint64 uid_checked_at;
-	gint64 pid_checked_at;
+	gint64 checked_at;
+	guint name_owner_changed_id;
 	bool uid_valid:1;
 	bool pid_valid:1;
 	char sender[0];
 } CallerInfo;
 
 typedef struct {
+	NMDBusManager *self;
+
+	/* the unique name of the client. */
+	char *name;
+
+	/* the high-volume interfaces for which the client wants to receive
+	 * PropertiesChanged signals. */
+	char **interfaces;
+
+	GCancellable *name_owner_cancellable;
+	guint name_owner_changed_id;
+} Subscriber;
+
+typedef struct {
+	/* the current value, as returned by Get/GetAll. */
 	GVariant *value;
+
+	/* while a PropertiesChanged signal is queued, the value that clients
+	 * got before the change. */
+	GVariant *value_notified;
+	bool notify_pending:1;
 } PropertyCacheData;
 
+typedef struct {
+	GType gtype;
+	const NMDBusInterfaceInfoExtended *interface_info;
+
+	/* maps the GParamSpec of a property to the index of the property
+	 * in @interface_info (plus one). */
+	GHashTable *idx_by_pspec;
+} PropertyIndex;
+
 typedef struct {
 	CList registration_lst;
 	NMDBusObject *obj;
 	NMDBusObjectClass *klass;
+	const PropertyIndex *property_index;
 	guint info_idx;
 	guint registration_id;
 	PropertyCacheData property_cache[];
@@ -78,11 +109,31 @@ typedef struct {
 
 	GDBusConnection *main_dbus_connection;
 
+	/* the CallerInfo of recent senders, by unique name. The list is
+	 * sorted by last use. */
+	GHashTable *caller_infos;
 	CList caller_info_lst_head;
 
+	/* the exported objects with pending property changes, in the order
+	 * in which they got notified first. */
+	CList notify_lst_head;
+	guint notify_idle_id;
+	guint notify_n_pending;
+
+	/* the method invocations that we did not reply to yet. */
+	GHashTable *pending_invocations;
+
+	/* set of PropertyIndex, for each GType and interface. */
+	GHashTable *property_indexes;
+
+	/* maps the unique name of a client to its Subscriber. */
+	GHashTable *subscribers;
+
 	guint objmgr_registration_id;
 	bool started:1;
 	bool shutting_down:1;
+	bool filter_signals:1;
+	bool subscribers_overflow:1;
 } NMDBusManagerPrivate;
 
 struct _NMDBusManager {
@@ -108,10 +159,11 @@ NM_DEFINE_SINGLETON_GETTER (NMDBusManager, nm_dbus_manager_get, NM_TYPE_DBUS_MAN
 /*****************************************************************************/
 
 static const GDBusInterfaceInfo interface_info_objmgr;
+static const GDBusInterfaceVTable dbus_vtable;
+static const GDBusInterfaceVTable dbus_vtable_objmgr;
 static const GDBusSignalInfo signal_info_objmgr_interfaces_added;
 static const GDBusSignalInfo signal_info_objmgr_interfaces_removed;
-static GVariantBuilder *_obj_collect_properties_all (NMDBusObject *obj,
-                                                     GVariantBuilder *builder);
+static GVariant *_obj_get_interfaces_and_properties (NMDBusObject *obj);
 
 /*****************************************************************************/
 
@@ -164,12 +216,22 @@ typedef struct {
 	CList object_mgr_lst_head;
 
 	NMDBusManager *manager;
+
+	/* whether the connections of this server see all our exported objects,
+	 * like clients on the bus do. */
+	bool export_objects:1;
 } PrivateServer;
 
 typedef struct {
 	CList object_mgr_lst;
+	GDBusConnection *connection;
 	GDBusObjectManagerServer *manager;
 	char *fake_sender;
+
+	/* for servers with @export_objects, maps the RegistrationData of an
+	 * exported interface to its registration-id on the connection. */
+	GHashTable *registrations;
+	guint objmgr_registration_id;
 } ObjectMgrData;
 
 typedef struct {
@@ -178,20 +240,36 @@ typedef struct {
 	gboolean remote_peer_vanished;
 } CloseConnectionInfo;
 
+static void _private_client_export_all (NMDBusManager *self,
+                                        ObjectMgrData *obj_mgr_data);
+
 /*****************************************************************************/
 
 static void
 _object_mgr_data_free (ObjectMgrData *obj_mgr_data)
 {
-	GDBusConnection *connection;
+	GDBusConnection *connection = obj_mgr_data->connection;
 
 	c_list_unlink_stale (&obj_mgr_data->object_mgr_lst);
 
-	connection = g_dbus_object_manager_server_get_connection (obj_mgr_data->manager);
+	if (obj_mgr_data->registrations) {
+		GHashTableIter iter;
+		gpointer registration_id;
+
+		g_hash_table_iter_init (&iter, obj_mgr_data->registrations);
+		while (g_hash_table_iter_next (&iter, NULL, &registration_id))
+			g_dbus_connection_unregister_object (connection, GPOINTER_TO_UINT (registration_id));
+		g_hash_table_unref (obj_mgr_data->registrations);
+	}
+	if (obj_mgr_data->objmgr_registration_id)
+		g_dbus_connection_unregister_object (connection, obj_mgr_data->objmgr_registration_id);
+
 	if (!g_dbus_connection_is_closed (connection))
 		g_dbus_connection_close (connection, NULL, NULL, NULL);
-	g_dbus_object_manager_server_set_connection (obj_mgr_data->manager, NULL);
-	g_object_unref (obj_mgr_data->manager);
+	if (obj_mgr_data->manager) {
+		g_dbus_object_manager_server_set_connection (obj_mgr_data->manager, NULL);
+		g_object_unref (obj_mgr_data->manager);
+	}
 	g_object_unref (connection);
 
 	g_free (obj_mgr_data->fake_sender);
@@ -222,10 +300,7 @@ close_connection_in_idle (gpointer user_data)
 		g_dbus_connection_close (info->connection, NULL, NULL, NULL);
 
 	c_list_for_each_entry_safe (obj_mgr_data, obj_mgr_data_safe, &server->object_mgr_lst_head, object_mgr_lst) {
-		gs_unref_object GDBusConnection *connection = NULL;
-
-		connection = g_dbus_object_manager_server_get_connection (obj_mgr_data->manager);
-		if (connection == info->connection) {
+		if (obj_mgr_data->connection == info->connection) {
 			_object_mgr_data_free (obj_mgr_data);
 			break;
 		}
@@ -269,7 +344,7 @@ private_server_new_connection (GDBusServer *server,
 	PrivateServer *s = user_data;
 	ObjectMgrData *obj_mgr_data;
 	static guint32 counter = 0;
-	GDBusObjectManagerServer *manager;
+	GDBusObjectManagerServer *manager = NULL;
 	char *sender;
 
 	g_signal_connect (conn, "closed", G_CALLBACK (private_server_closed_connection), s);
@@ -277,16 +352,22 @@ private_server_new_connection (GDBusServer *server,
 	/* Fake a sender since private connections don't have one */
 	sender = g_strdup_printf ("x:y:%d", counter++);
 
-	manager = g_dbus_object_manager_server_new (OBJECT_MANAGER_SERVER_BASE_PATH);
-	g_dbus_object_manager_server_set_connection (manager, conn);
+	if (!s->export_objects) {
+		manager = g_dbus_object_manager_server_new (OBJECT_MANAGER_SERVER_BASE_PATH);
+		g_dbus_object_manager_server_set_connection (manager, conn);
+	}
 
-	obj_mgr_data = g_slice_new (ObjectMgrData);
+	obj_mgr_data = g_slice_new0 (ObjectMgrData);
+	obj_mgr_data->connection = g_object_ref (conn);
 	obj_mgr_data->manager = manager;
 	obj_mgr_data->fake_sender = sender;
 	c_list_link_tail (&s->object_mgr_lst_head, &obj_mgr_data->object_mgr_lst);
 
 	_LOGD ("(%s) accepted connection %p on private socket", s->tag, conn);
 
+	if (s->export_objects)
+		_private_client_export_all (s->manager, obj_mgr_data);
+
 	/* Emit this for the manager.
 	 *
 	 * It is essential to do this from the "new-connection" signal handler, as
@@ -340,10 +421,11 @@ private_server_free (gpointer ptr)
 	g_slice_free (PrivateServer, s);
 }
 
-void
-nm_dbus_manager_private_server_register (NMDBusManager *self,
-                                         const char *path,
-                                         const char *tag)
+static void
+_private_server_register (NMDBusManager *self,
+                          const char *path,
+                          const char *tag,
+                          gboolean export_objects)
 {
 	NMDBusManagerPrivate *priv;
 	PrivateServer *s;
@@ -400,12 +482,39 @@ nm_dbus_manager_private_server_register (NMDBusManager *self,
 	s->manager = self;
 	s->detail = g_quark_from_string (tag);
 	s->tag = g_quark_to_string (s->detail);
+	s->export_objects = export_objects;
 
 	c_list_link_tail (&priv->private_servers_lst_head, &s->private_servers_lst);
 
 	g_dbus_server_start (server);
 }
 
+void
+nm_dbus_manager_private_server_register (NMDBusManager *self,
+                                         const char *path,
+                                         const char *tag)
+{
+	_private_server_register (self, path, tag, FALSE);
+}
+
+/**
+ * nm_dbus_manager_private_client_server_register:
+ * @self: the #NMDBusManager
+ * @path: the path of the unix socket
+ *
+ * Creates a private server for local clients. Unlike with other private
+ * servers, the connections see the same objects and signals as clients on
+ * the system bus. As with the other private servers, only root may connect.
+ * That allows short-lived tools to query the state without going through
+ * the message bus.
+ */
+void
+nm_dbus_manager_private_client_server_register (NMDBusManager *self,
+                                                const char *path)
+{
+	_private_server_register (self, path, "client", TRUE);
+}
+
 static const char *
 private_server_get_connection_owner (PrivateServer *s, GDBusConnection *connection)
 {
@@ -415,10 +524,7 @@ private_server_get_connection_owner (PrivateServer *s, GDBusConnection *connecti
 	nm_assert (G_IS_DBUS_CONNECTION (connection));
 
 	c_list_for_each_entry (obj_mgr_data, &s->object_mgr_lst_head, object_mgr_lst) {
-		gs_unref_object GDBusConnection *c = NULL;
-
-		c = g_dbus_object_manager_server_get_connection (obj_mgr_data->manager);
-		if (c == connection)
+		if (obj_mgr_data->connection == connection)
 			return obj_mgr_data->fake_sender;
 	}
 	return NULL;
@@ -434,7 +540,7 @@ private_server_get_connection_by_owner (PrivateServer *s, const char *owner)
 
 	c_list_for_each_entry (obj_mgr_data, &s->object_mgr_lst_head, object_mgr_lst) {
 		if (nm_streq (owner, obj_mgr_data->fake_sender))
-			return g_dbus_object_manager_server_get_connection (obj_mgr_data->manager);
+			return g_object_ref (obj_mgr_data->connection);
 	}
 	return NULL;
 }
@@ -442,12 +548,48 @@ private_server_get_connection_by_owner (PrivateServer *s, const char *owner)
 /*****************************************************************************/
 
 static void
-_caller_info_free (CallerInfo *caller_info)
+_caller_info_free (NMDBusManager *self,
+                   CallerInfo *caller_info)
 {
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+
+	nm_clear_g_dbus_connection_signal (priv->main_dbus_connection,
+	                                   &caller_info->name_owner_changed_id);
+	if (!g_hash_table_remove (priv->caller_infos, caller_info->sender))
+		nm_assert_not_reached ();
 	c_list_unlink_stale (&caller_info->caller_info_lst);
 	g_free (caller_info);
 }
 
+static void
+_caller_info_name_owner_changed_cb (GDBusConnection *dbus_connection,
+                                    const char *sender_name,
+                                    const char *object_path,
+                                    const char *interface_name,
+                                    const char *signal_name,
+                                    GVariant *parameters,
+                                    gpointer user_data)
+{
+	NMDBusManager *self = user_data;
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	CallerInfo *caller_info;
+	const char *name;
+	const char *new_owner;
+
+	if (!g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(sss)")))
+		return;
+
+	g_variant_get (parameters, "(&s&s&s)", &name, NULL, &new_owner);
+	if (new_owner[0])
+		return;
+
+	/* unique names are never reused. Once the client disconnects,
+	 * its entry is useless. */
+	caller_info = g_hash_table_lookup (priv->caller_infos, name);
+	if (caller_info)
+		_caller_info_free (self, caller_info);
+}
+
 static gboolean
 _bus_get_unix_pid (NMDBusManager *self,
                    const char *sender,
@@ -512,74 +654,113 @@ _bus_get_unix_user (NMDBusManager *self,
 	return TRUE;
 }
 
+/* Fetches the uid and the pid of the sender with a single
+ * GetConnectionCredentials() call. Returns FALSE if the bus doesn't
+ * support that method. */
+static gboolean
+_bus_get_credentials (NMDBusManager *self,
+                      CallerInfo *caller_info)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	gs_unref_variant GVariant *ret = NULL;
+	gs_unref_variant GVariant *credentials = NULL;
+	gs_free_error GError *error = NULL;
+	guint32 v;
+
+	if (!priv->main_dbus_connection)
+		return TRUE;
+
+	ret = g_dbus_connection_call_sync (priv->main_dbus_connection,
+	                                   DBUS_SERVICE_DBUS,
+	                                   DBUS_PATH_DBUS,
+	                                   DBUS_INTERFACE_DBUS,
+	                                   "GetConnectionCredentials",
+	                                   g_variant_new ("(s)", caller_info->sender),
+	                                   G_VARIANT_TYPE ("(a{sv})"),
+	                                   G_DBUS_CALL_FLAGS_NONE,
+	                                   2000,
+	                                   NULL,
+	                                   &error);
+	if (!ret)
+		return !g_error_matches (error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD);
+
+	g_variant_get (ret, "(@a{sv})", &credentials);
+
+	if (g_variant_lookup (credentials, "UnixUserID", "u", &v)) {
+		caller_info->uid = v;
+		caller_info->uid_valid = TRUE;
+	}
+	if (g_variant_lookup (credentials, "ProcessID", "u", &v)) {
+		caller_info->pid = v;
+		caller_info->pid_valid = TRUE;
+	}
+	return TRUE;
+}
+
 static const CallerInfo *
 _get_caller_info_ensure (NMDBusManager *self,
-                         const char *sender,
-                         gboolean ensure_uid,
-                         gboolean ensure_pid)
+                         const char *sender)
 {
 	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
 	CallerInfo *caller_info;
-	CallerInfo *ci;
 	gint64 now_ns;
-	gsize num;
 
 #define CALLER_INFO_MAX_AGE   (NM_UTILS_NSEC_PER_SEC * 1)
+#define CALLER_INFO_MAX_NUM   64
 
-	/* Linear search the cache for the sender.
-	 *
-	 * The number of cached caller-infos is limited. Hence, it's O(1) and
-	 * the list is reasonably short.
-	 * Also, the entire caching assumes that we repeatedly ask for the
-	 * same sender. That means, we expect to find the right caller info
-	 * at the front of the list. */
-	num = 1;
-	caller_info = NULL;
-	c_list_for_each_entry (ci, &priv->caller_info_lst_head, caller_info_lst) {
-		if (nm_streq (sender, ci->sender)) {
-			caller_info = ci;
-			break;
-		}
-		num++;
-	}
+	/* The credentials of a unique name don't change while the client is
+	 * connected to the bus. Hence, a complete entry stays valid until we
+	 * see the name vanish. Only failed lookups are retried after a while. */
+	now_ns = nm_utils_get_monotonic_timestamp_nsec ();
 
-	if (caller_info)
+	caller_info = g_hash_table_lookup (priv->caller_infos, sender);
+	if (caller_info) {
 		nm_c_list_move_front (&priv->caller_info_lst_head, &caller_info->caller_info_lst);
-	else {
+		if (   (   caller_info->uid_valid
+		        && caller_info->pid_valid)
+		    || (now_ns - caller_info->checked_at) <= CALLER_INFO_MAX_AGE)
+			return caller_info;
+	} else {
 		gsize l = strlen (sender) + 1;
 
 		caller_info = g_malloc (sizeof (CallerInfo) + l);
 		*caller_info = (CallerInfo) {
-			.uid_checked_at = - CALLER_INFO_MAX_AGE,
-			.pid_checked_at = - CALLER_INFO_MAX_AGE,
+			.uid = G_MAXULONG,
+			.pid = G_MAXULONG,
 		};
 		memcpy (caller_info->sender, sender, l);
 		c_list_link_front (&priv->caller_info_lst_head, &caller_info->caller_info_lst);
-
-		/* only cache the last few entries. */
-		while (TRUE) {
-			nm_assert (num > 0 && num == c_list_length (&priv->caller_info_lst_head));
-			if (num-- <= 5)
-				break;
-			_caller_info_free (c_list_last_entry (&priv->caller_info_lst_head, CallerInfo, caller_info_lst));
+		g_hash_table_add (priv->caller_infos, caller_info->sender);
+
+		/* subscribe before fetching the credentials. If the name vanishes
+		 * afterwards, we are sure to get notified. */
+		if (priv->main_dbus_connection) {
+			caller_info->name_owner_changed_id = nm_dbus_connection_signal_subscribe_name_owner_changed (priv->main_dbus_connection,
+			                                                                                             caller_info->sender,
+			                                                                                             _caller_info_name_owner_changed_cb,
+			                                                                                             self,
+			                                                                                             NULL);
 		}
+
+		if (g_hash_table_size (priv->caller_infos) > CALLER_INFO_MAX_NUM)
+			_caller_info_free (self, c_list_last_entry (&priv->caller_info_lst_head, CallerInfo, caller_info_lst));
 	}
 
-	now_ns = nm_utils_get_monotonic_timestamp_nsec ();
+	caller_info->checked_at = now_ns;
+	caller_info->uid = G_MAXULONG;
+	caller_info->pid = G_MAXULONG;
+	caller_info->uid_valid = FALSE;
+	caller_info->pid_valid = FALSE;
 
-	if (   ensure_uid
-	    && (now_ns - caller_info->uid_checked_at) > CALLER_INFO_MAX_AGE) {
-		caller_info->uid_checked_at = now_ns;
-		if (!(caller_info->uid_valid = _bus_get_unix_user (self, sender, &caller_info->uid)))
-			caller_info->uid = G_MAXULONG;
+	if (!_bus_get_credentials (self, caller_info)) {
+		caller_info->uid_valid = _bus_get_unix_user (self, sender, &caller_info->uid);
+		caller_info->pid_valid = _bus_get_unix_pid (self, sender, &caller_info->pid);
 	}
 
-	if (   ensure_pid
-	    && (now_ns - caller_info->pid_checked_at) > CALLER_INFO_MAX_AGE) {
-		caller_info->pid_checked_at = now_ns;
-		if (!(caller_info->pid_valid = _bus_get_unix_pid (self, sender, &caller_info->pid)))
-			caller_info->pid = G_MAXULONG;
-	}
+	_LOGT ("caller-info: %s has uid %ld and pid %ld",
+	       sender,
+	       caller_info->uid_valid ? (long) caller_info->uid : -1l,
+	       caller_info->pid_valid ? (long) caller_info->pid : -1l);
 
 	return caller_info;
 }
@@ -642,7 +823,7 @@ _get_caller_info (NMDBusManager *self,
 		return FALSE;
 	}
 
-	caller_info = _get_caller_info_ensure (self, sender, !!out_uid, !!out_pid);
+	caller_info = _get_caller_info_ensure (self, sender);
 
 	NM_SET_OUT (out_sender, caller_info->sender);
 	NM_SET_OUT (out_uid, caller_info->uid);
@@ -748,7 +929,7 @@ nm_dbus_manager_get_unix_user (NMDBusManager *self,
 	}
 
 	/* Otherwise, a bus connection */
-	caller_info = _get_caller_info_ensure (self, sender, TRUE, FALSE);
+	caller_info = _get_caller_info_ensure (self, sender);
 	*out_uid = caller_info->uid;
 	if (!caller_info->uid_valid) {
 		_LOGW ("failed to get unix user for dbus sender '%s'", sender);
@@ -769,6 +950,38 @@ _reg_data_get_interface_info (RegistrationData *reg_data)
 
 /*****************************************************************************/
 
+static void _obj_notify_flush (NMDBusManager *self);
+
+static void
+_invocation_finalized_cb (gpointer user_data, GObject *where_the_object_was)
+{
+	NMDBusManager *self = user_data;
+
+	if (!g_hash_table_remove (NM_DBUS_MANAGER_GET_PRIVATE (self)->pending_invocations, where_the_object_was))
+		nm_assert_not_reached ();
+}
+
+/* Property changes are usually emitted from an idle handler. But the
+ * caller of a method must see the changes before the reply, and the
+ * replies are sent from all over the place. So, as long as we did not
+ * reply to a method call, emit property changes right away. The
+ * invocation gets destroyed after sending the reply. */
+static void
+_invocation_track (NMDBusManager *self,
+                   GDBusMethodInvocation *invocation)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+
+	/* the changes that happened before the call, must also be seen first. */
+	_obj_notify_flush (self);
+
+	if (!priv->pending_invocations)
+		priv->pending_invocations = g_hash_table_new (nm_direct_hash, NULL);
+	if (!g_hash_table_add (priv->pending_invocations, invocation))
+		nm_assert_not_reached ();
+	g_object_weak_ref (G_OBJECT (invocation), _invocation_finalized_cb, self);
+}
+
 static void
 dbus_vtable_method_call (GDBusConnection *connection,
                          const char *sender,
@@ -821,6 +1034,7 @@ dbus_vtable_method_call (GDBusConnection *connection,
 			return;
 		}
 
+		_invocation_track (self, invocation);
 		priv->set_property_handler (obj,
 		                            interface_info,
 		                            property_info,
@@ -856,6 +1070,7 @@ dbus_vtable_method_call (GDBusConnection *connection,
 		return;
 	}
 
+	_invocation_track (self, invocation);
 	method_info->handle (reg_data->obj,
 	                     interface_info,
 	                     method_info,
@@ -922,6 +1137,226 @@ static const GDBusInterfaceVTable dbus_vtable = {
 	.set_property = NULL,
 };
 
+static guint
+_property_index_hash (gconstpointer ptr)
+{
+	const PropertyIndex *idx = ptr;
+	NMHashState h;
+
+	nm_hash_init (&h, 1579457219u);
+	nm_hash_update_vals (&h, idx->gtype, idx->interface_info);
+	return nm_hash_complete (&h);
+}
+
+static gboolean
+_property_index_equal (gconstpointer a, gconstpointer b)
+{
+	const PropertyIndex *idx_a = a;
+	const PropertyIndex *idx_b = b;
+
+	return    idx_a->gtype == idx_b->gtype
+	       && idx_a->interface_info == idx_b->interface_info;
+}
+
+static void
+_property_index_free (gpointer ptr)
+{
+	PropertyIndex *idx = ptr;
+
+	g_hash_table_unref (idx->idx_by_pspec);
+	g_slice_free (PropertyIndex, idx);
+}
+
+/* Returns the (cached) index to find the properties of @interface_info
+ * by the GParamSpec that is used for notifications. The index is built
+ * for the concrete type of @obj, because the same interface info can be
+ * used by unrelated types. */
+static const PropertyIndex *
+_property_index_get (NMDBusManager *self,
+                     NMDBusObject *obj,
+                     const NMDBusInterfaceInfoExtended *interface_info)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	GObjectClass *object_class = G_OBJECT_GET_CLASS (obj);
+	PropertyIndex needle = {
+		.gtype          = G_OBJECT_TYPE (obj),
+		.interface_info = interface_info,
+	};
+	PropertyIndex *idx;
+	guint i;
+
+	if (G_UNLIKELY (!priv->property_indexes)) {
+		priv->property_indexes = g_hash_table_new_full (_property_index_hash,
+		                                                _property_index_equal,
+		                                                _property_index_free,
+		                                                NULL);
+	}
+
+	idx = g_hash_table_lookup (priv->property_indexes, &needle);
+	if (idx)
+		return idx;
+
+	idx = g_slice_new (PropertyIndex);
+	*idx = needle;
+	idx->idx_by_pspec = g_hash_table_new (nm_direct_hash, NULL);
+
+	if (interface_info->parent.properties) {
+		for (i = 0; interface_info->parent.properties[i]; i++) {
+			const NMDBusPropertyInfoExtended *property_info = (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
+			GParamSpec *pspec;
+			GParamSpec *redirect;
+
+			pspec = g_object_class_find_property (object_class, property_info->property_name);
+			if (!pspec) {
+				nm_assert_not_reached ();
+				continue;
+			}
+
+			/* notifications for overridden properties are emitted with the
+			 * original GParamSpec. */
+			redirect = g_param_spec_get_redirect_target (pspec);
+			if (redirect)
+				pspec = redirect;
+
+			g_hash_table_insert (idx->idx_by_pspec, pspec, GUINT_TO_POINTER (i + 1));
+		}
+	}
+
+	g_hash_table_add (priv->property_indexes, idx);
+	return idx;
+}
+
+/*****************************************************************************/
+
+static void
+_private_client_register_obj (NMDBusManager *self,
+                              ObjectMgrData *obj_mgr_data,
+                              NMDBusObject *obj)
+{
+	RegistrationData *reg_data;
+
+	c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+		const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info (reg_data);
+		gs_free_error GError *error = NULL;
+		guint registration_id;
+
+		registration_id = g_dbus_connection_register_object (obj_mgr_data->connection,
+		                                                     obj->internal.path,
+		                                                     NM_UNCONST_PTR (GDBusInterfaceInfo, &interface_info->parent),
+		                                                     &dbus_vtable,
+		                                                     reg_data,
+		                                                     NULL,
+		                                                     &error);
+		if (!registration_id) {
+			_LOGD ("failure to register object %s on private connection %p: %s",
+			       obj->internal.path, obj_mgr_data->connection, error->message);
+			continue;
+		}
+
+		g_hash_table_insert (obj_mgr_data->registrations, reg_data, GUINT_TO_POINTER (registration_id));
+	}
+}
+
+static void
+_private_client_unregister_reg_data (NMDBusManager *self,
+                                     RegistrationData *reg_data)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	PrivateServer *s;
+	ObjectMgrData *obj_mgr_data;
+	gpointer registration_id;
+
+	c_list_for_each_entry (s, &priv->private_servers_lst_head, private_servers_lst) {
+		if (!s->export_objects)
+			continue;
+		c_list_for_each_entry (obj_mgr_data, &s->object_mgr_lst_head, object_mgr_lst) {
+			if (g_hash_table_steal_extended (obj_mgr_data->registrations, reg_data, NULL, &registration_id))
+				g_dbus_connection_unregister_object (obj_mgr_data->connection, GPOINTER_TO_UINT (registration_id));
+		}
+	}
+}
+
+static void
+_private_client_export_all (NMDBusManager *self,
+                            ObjectMgrData *obj_mgr_data)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	gs_free_error GError *error = NULL;
+	NMDBusObject *obj;
+
+	nm_assert (!obj_mgr_data->registrations);
+
+	obj_mgr_data->registrations = g_hash_table_new (nm_direct_hash, NULL);
+
+	obj_mgr_data->objmgr_registration_id = g_dbus_connection_register_object (obj_mgr_data->connection,
+	                                                                          OBJECT_MANAGER_SERVER_BASE_PATH,
+	                                                                          NM_UNCONST_PTR (GDBusInterfaceInfo, &interface_info_objmgr),
+	                                                                          &dbus_vtable_objmgr,
+	                                                                          self,
+	                                                                          NULL,
+	                                                                          &error);
+	if (!obj_mgr_data->objmgr_registration_id) {
+		_LOGW ("failure to register object manager on private connection %p: %s",
+		       obj_mgr_data->connection, error->message);
+		return;
+	}
+
+	/* objects that are not yet registered on the bus get exported later,
+	 * by _obj_register(). */
+	c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst)
+		_private_client_register_obj (self, obj_mgr_data, obj);
+}
+
+static void
+_emit_signal_private (NMDBusManager *self,
+                      const char *path,
+                      const char *interface_name,
+                      const char *signal_name,
+                      GVariant *args)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	PrivateServer *s;
+	ObjectMgrData *obj_mgr_data;
+
+	c_list_for_each_entry (s, &priv->private_servers_lst_head, private_servers_lst) {
+		if (!s->export_objects)
+			continue;
+		c_list_for_each_entry (obj_mgr_data, &s->object_mgr_lst_head, object_mgr_lst) {
+			if (!obj_mgr_data->objmgr_registration_id)
+				continue;
+			g_dbus_connection_emit_signal (obj_mgr_data->connection,
+			                               NULL,
+			                               path,
+			                               interface_name,
+			                               signal_name,
+			                               args,
+			                               NULL);
+		}
+	}
+}
+
+/* Broadcasts a signal to the clients on the bus and to the private
+ * connections that see our objects. */
+static void
+_emit_signal (NMDBusManager *self,
+              const char *path,
+              const char *interface_name,
+              const char *signal_name,
+              GVariant *args)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	gs_unref_variant GVariant *args_sunk = g_variant_ref_sink (args);
+
+	g_dbus_connection_emit_signal (priv->main_dbus_connection,
+	                               NULL,
+	                               path,
+	                               interface_name,
+	                               signal_name,
+	                               args_sunk,
+	                               NULL);
+	_emit_signal_private (self, path, interface_name, signal_name, args_sunk);
+}
+
 static void
 _obj_register (NMDBusManager *self,
                NMDBusObject *obj)
@@ -932,7 +1367,8 @@ _obj_register (NMDBusManager *self,
 	GType gtype;
 	NMDBusObjectClass *klasses[10];
 	const NMDBusInterfaceInfoExtended *const*prev_interface_infos = NULL;
-	GVariantBuilder builder;
+	PrivateServer *s;
+	ObjectMgrData *obj_mgr_data;
 
 	nm_assert (c_list_is_empty (&obj->internal.registration_lst_head));
 	nm_assert (priv->main_dbus_connection);
@@ -988,6 +1424,7 @@ _obj_register (NMDBusManager *self,
 
 			reg_data->obj = obj;
 			reg_data->klass = g_type_class_ref (G_TYPE_FROM_CLASS (klass));
+			reg_data->property_index = _property_index_get (self, obj, interface_info);
 			reg_data->info_idx = i;
 			reg_data->registration_id = registration_id;
 			c_list_link_tail (&obj->internal.registration_lst_head, &reg_data->registration_lst);
@@ -999,6 +1436,15 @@ _obj_register (NMDBusManager *self,
 
 	nm_assert (!c_list_is_empty (&obj->internal.registration_lst_head));
 
+	c_list_for_each_entry (s, &priv->private_servers_lst_head, private_servers_lst) {
+		if (!s->export_objects)
+			continue;
+		c_list_for_each_entry (obj_mgr_data, &s->object_mgr_lst_head, object_mgr_lst) {
+			if (obj_mgr_data->objmgr_registration_id)
+				_private_client_register_obj (self, obj_mgr_data, obj);
+		}
+	}
+
 	/* Currently the interfaces of an object do not changed and strictly depend on the object glib type.
 	 * We don't need more flixibility, and it simplifies the code. Hence, now emit interface-added
 	 * signal for the new object.
@@ -1012,15 +1458,13 @@ _obj_register (NMDBusManager *self,
 	 *
 	 * In general, it's ok to export an object with frozen signals. But you better make sure
 	 * that all properties are in a self-consistent state when exporting the object. */
-	g_dbus_connection_emit_signal (priv->main_dbus_connection,
-	                               NULL,
-	                               OBJECT_MANAGER_SERVER_BASE_PATH,
-	                               interface_info_objmgr.name,
-	                               signal_info_objmgr_interfaces_added.name,
-	                               g_variant_new ("(oa{sa{sv}})",
-	                                              obj->internal.path,
-	                                              _obj_collect_properties_all (obj, &builder)),
-	                               NULL);
+	_emit_signal (self,
+	              OBJECT_MANAGER_SERVER_BASE_PATH,
+	              interface_info_objmgr.name,
+	              signal_info_objmgr_interfaces_added.name,
+	              g_variant_new ("(o@a{sa{sv}})",
+	                             obj->internal.path,
+	                             _obj_get_interfaces_and_properties (obj)));
 }
 
 static void
@@ -1049,25 +1493,28 @@ _obj_unregister (NMDBusManager *self,
 		c_list_unlink_stale (&reg_data->registration_lst);
 		if (!g_dbus_connection_unregister_object (priv->main_dbus_connection, reg_data->registration_id))
 			nm_assert_not_reached ();
+		_private_client_unregister_reg_data (self, reg_data);
 
 		if (interface_info->parent.properties) {
-			for (i = 0; interface_info->parent.properties[i]; i++)
+			for (i = 0; interface_info->parent.properties[i]; i++) {
 				nm_clear_g_variant (&reg_data->property_cache[i].value);
+				nm_clear_g_variant (&reg_data->property_cache[i].value_notified);
+			}
 		}
 
 		g_type_class_unref (reg_data->klass);
 		g_free (reg_data);
 	}
 
-	g_dbus_connection_emit_signal (priv->main_dbus_connection,
-	                               NULL,
-	                               OBJECT_MANAGER_SERVER_BASE_PATH,
-	                               interface_info_objmgr.name,
-	                               signal_info_objmgr_interfaces_removed.name,
-	                               g_variant_new ("(oas)",
-	                                              obj->internal.path,
-	                                              &builder),
-	                               NULL);
+	nm_clear_g_variant (&obj->internal.interfaces_and_properties);
+
+	_emit_signal (self,
+	              OBJECT_MANAGER_SERVER_BASE_PATH,
+	              interface_info_objmgr.name,
+	              signal_info_objmgr_interfaces_removed.name,
+	              g_variant_new ("(oas)",
+	                             obj->internal.path,
+	                             &builder));
 }
 
 gpointer
@@ -1110,8 +1557,10 @@ _nm_dbus_manager_obj_export (NMDBusObject *obj)
 		nm_assert_not_reached ();
 	c_list_link_tail (&priv->objects_lst_head, &obj->internal.objects_lst);
 
-	if (priv->started)
+	if (priv->started) {
+		_obj_notify_flush (self);
 		_obj_register (self, obj);
+	}
 }
 
 void
@@ -1131,9 +1580,12 @@ _nm_dbus_manager_obj_unexport (NMDBusObject *obj)
 	nm_assert (&obj->internal == g_hash_table_lookup (priv->objects_by_path, &obj->internal));
 	nm_assert (c_list_contains (&priv->objects_lst_head, &obj->internal.objects_lst));
 
-	if (priv->started)
+	if (priv->started) {
+		/* this also emits the pending changes of other objects, that might
+		 * drop their reference to @obj. */
+		_obj_notify_flush (self);
 		_obj_unregister (self, obj);
-	else
+	} else
 		nm_assert (c_list_is_empty (&obj->internal.registration_lst_head));
 
 	if (!g_hash_table_remove (priv->objects_by_path, &obj->internal))
@@ -1141,34 +1593,94 @@ _nm_dbus_manager_obj_unexport (NMDBusObject *obj)
 	c_list_unlink (&obj->internal.objects_lst);
 }
 
-void
-_nm_dbus_manager_obj_notify (NMDBusObject *obj,
-                             guint n_pspecs,
-                             const GParamSpec *const*pspecs)
+/* A unicast signal is routed by dbus-daemon straight to its destination,
+ * while a broadcast signal is matched against the match rules of every
+ * client on the bus. But with unicast, every subscriber costs a message
+ * of its own. With more subscribers than this, one broadcast is cheaper. */
+#define SUBSCRIBERS_UNICAST_MAX 8
+
+/* Emits a PropertiesChanged signal (or a legacy signal) for @interface_info.
+ * For high-volume interfaces, the signal is only sent to the subscribed
+ * clients, if signal filtering is enabled. Returns the number of emitted
+ * signals. */
+static guint
+_emit_properties_changed_signal (NMDBusManager *self,
+                                 const NMDBusInterfaceInfoExtended *interface_info,
+                                 const char *path,
+                                 const char *interface_name,
+                                 GVariant *args)
 {
-	NMDBusManager *self;
-	NMDBusManagerPrivate *priv;
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	gs_unref_variant GVariant *args_sunk = NULL;
+	GHashTableIter iter;
+	Subscriber *subscriber;
+	guint n_subscribers = 0;
+	guint n_signals = 0;
+
+	if (   priv->filter_signals
+	    && interface_info->high_volume
+	    && !priv->subscribers_overflow) {
+		if (priv->subscribers) {
+			g_hash_table_iter_init (&iter, priv->subscribers);
+			while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &subscriber)) {
+				if (nm_utils_strv_find_first (subscriber->interfaces, -1, interface_info->parent.name) >= 0)
+					n_subscribers++;
+			}
+		}
+	} else
+		n_subscribers = G_MAXUINT;
+
+	if (n_subscribers > SUBSCRIBERS_UNICAST_MAX) {
+		_emit_signal (self,
+		              path,
+		              interface_name,
+		              "PropertiesChanged",
+		              args);
+		return 1;
+	}
+
+	args_sunk = g_variant_ref_sink (args);
+
+	_emit_signal_private (self, path, interface_name, "PropertiesChanged", args_sunk);
+
+	if (n_subscribers == 0)
+		return 0;
+
+	g_hash_table_iter_init (&iter, priv->subscribers);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &subscriber)) {
+		if (nm_utils_strv_find_first (subscriber->interfaces, -1, interface_info->parent.name) < 0)
+			continue;
+		n_signals++;
+		g_dbus_connection_emit_signal (priv->main_dbus_connection,
+		                               subscriber->name,
+		                               path,
+		                               interface_name,
+		                               "PropertiesChanged",
+		                               args_sunk,
+		                               NULL);
+	}
+
+	return n_signals;
+}
+
+static guint
+_obj_emit_properties_changed (NMDBusManager *self,
+                              NMDBusObject *obj,
+                              guint n_pspecs,
+                              const GParamSpec *const*pspecs)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
 	RegistrationData *reg_data;
 	guint i, p;
 	gboolean any_legacy_signals = FALSE;
 	gboolean any_legacy_properties = FALSE;
 	GVariantBuilder legacy_builder;
 	GVariant *device_statistics_args = NULL;
+	guint n_signals = 0;
 
 	nm_assert (NM_IS_DBUS_OBJECT (obj));
 	nm_assert (obj->internal.path);
-	nm_assert (NM_IS_DBUS_MANAGER (obj->internal.bus_manager));
-	nm_assert (!c_list_is_empty (&obj->internal.objects_lst));
-
-	self = obj->internal.bus_manager;
-	priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
-
-	nm_assert (!priv->started || priv->objmgr_registration_id != 0);
-	nm_assert (priv->objmgr_registration_id == 0 || priv->main_dbus_connection);
-	nm_assert (c_list_is_empty (&obj->internal.registration_lst_head) != priv->started);
-
-	if (G_UNLIKELY (!priv->started))
-		return;
+	nm_assert (priv->started);
 
 	c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
 		if (_reg_data_get_interface_info (reg_data)->legacy_property_changed) {
@@ -1177,51 +1689,80 @@ _nm_dbus_manager_obj_notify (NMDBusObject *obj,
 		}
 	}
 
-	/* do a naive search for the matching NMDBusPropertyInfoExtended infos. Since the number of
-	 * (interfaces x properties) is static and possibly small, this naive search is effectively
-	 * O(1). We might wanna introduce some index to lookup the properties in question faster.
-	 *
-	 * The nice part of this implementation is however, that the order in which properties
-	 * are added to the GVariant is strictly defined to be the order in which the D-Bus property-info
-	 * is declared. Getting a defined ordering with some smart lookup would be hard. */
 	c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
 		const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info (reg_data);
 		gboolean has_properties = FALSE;
 		GVariantBuilder builder;
 		GVariantBuilder invalidated_builder;
 		GVariant *args;
+		guint idxs_stack[16];
+		gs_free guint *idxs_heap = NULL;
+		guint *idxs;
+		guint n_idxs = 0;
 
 		if (!interface_info->parent.properties)
 			continue;
 
-		for (i = 0; interface_info->parent.properties[i]; i++) {
-			const NMDBusPropertyInfoExtended *property_info = (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
+		idxs =   n_pspecs <= G_N_ELEMENTS (idxs_stack)
+		       ? idxs_stack
+		       : (idxs_heap = g_new (guint, n_pspecs));
 
-			for (p = 0; p < n_pspecs; p++) {
-				const GParamSpec *pspec = pspecs[p];
-				gs_unref_variant GVariant *value = NULL;
+		/* find the properties of this interface. Keep them sorted, because the order
+		 * in which properties are added to the GVariant is strictly defined to be the
+		 * order in which the D-Bus property-info is declared. */
+		for (p = 0; p < n_pspecs; p++) {
+			guint idx;
 
-				if (!nm_streq (property_info->property_name, pspec->name))
-					continue;
+			idx = GPOINTER_TO_UINT (g_hash_table_lookup (reg_data->property_index->idx_by_pspec, pspecs[p]));
+			if (idx == 0)
+				continue;
+			idx--;
 
-				value = _obj_get_property (reg_data, i, TRUE);
+			for (i = n_idxs; i > 0 && idxs[i - 1] > idx; i--)
+				idxs[i] = idxs[i - 1];
+			idxs[i] = idx;
+			n_idxs++;
+		}
 
-				if (   property_info->include_in_legacy_property_changed
-				    && any_legacy_signals) {
-					/* also track the value in the legacy_builder to emit legacy signals below. */
-					if (!any_legacy_properties) {
-						any_legacy_properties = TRUE;
-						g_variant_builder_init (&legacy_builder, G_VARIANT_TYPE ("a{sv}"));
-					}
-					g_variant_builder_add (&legacy_builder, "{sv}", property_info->parent.name, value);
-				}
+		for (p = 0; p < n_idxs; p++) {
+			const NMDBusPropertyInfoExtended *property_info;
+			PropertyCacheData *cache;
+			gs_unref_variant GVariant *value_old = NULL;
+			gs_unref_variant GVariant *value = NULL;
+
+			i = idxs[p];
+			property_info = (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
+			cache = &reg_data->property_cache[i];
+
+			if (!cache->notify_pending)
+				continue;
+			cache->notify_pending = FALSE;
+
+			/* the value from before the change is what clients last saw. Don't notify
+			 * about properties that didn't actually change. */
+			value_old = g_steal_pointer (&cache->value_notified);
+			value = _obj_get_property (reg_data, i, FALSE);
+			if (   value_old
+			    && g_variant_equal (value_old, value))
+				continue;
 
-				if (!has_properties) {
-					has_properties = TRUE;
-					g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+			nm_clear_g_variant (&obj->internal.interfaces_and_properties);
+
+			if (   property_info->include_in_legacy_property_changed
+			    && any_legacy_signals) {
+				/* also track the value in the legacy_builder to emit legacy signals below. */
+				if (!any_legacy_properties) {
+					any_legacy_properties = TRUE;
+					g_variant_builder_init (&legacy_builder, G_VARIANT_TYPE ("a{sv}"));
 				}
-				g_variant_builder_add (&builder, "{sv}", property_info->parent.name, value);
+				g_variant_builder_add (&legacy_builder, "{sv}", property_info->parent.name, value);
 			}
+
+			if (!has_properties) {
+				has_properties = TRUE;
+				g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+			}
+			g_variant_builder_add (&builder, "{sv}", property_info->parent.name, value);
 		}
 
 		if (!has_properties)
@@ -1237,30 +1778,27 @@ _nm_dbus_manager_obj_notify (NMDBusObject *obj,
 		}
 
 		g_variant_builder_init (&invalidated_builder, G_VARIANT_TYPE ("as"));
-		g_dbus_connection_emit_signal (priv->main_dbus_connection,
-		                               NULL,
-		                               obj->internal.path,
-		                               "org.freedesktop.DBus.Properties",
-		                               "PropertiesChanged",
-		                               g_variant_new ("(s@a{sv}as)",
-		                                              interface_info->parent.name,
-		                                              args,
-		                                              &invalidated_builder),
-		                               NULL);
+		n_signals += _emit_properties_changed_signal (self,
+		                                              interface_info,
+		                                              obj->internal.path,
+		                                              "org.freedesktop.DBus.Properties",
+		                                              g_variant_new ("(s@a{sv}as)",
+		                                                             interface_info->parent.name,
+		                                                             args,
+		                                                             &invalidated_builder));
 	}
 
 	if (G_UNLIKELY (device_statistics_args)) {
 		/* this is a special interface: it has a legacy PropertiesChanged signal,
 		 * however, contrary to other interfaces with ~regular~ legacy signals,
 		 * we only notify about properties that actually belong to this interface. */
-		g_dbus_connection_emit_signal (priv->main_dbus_connection,
-		                               NULL,
-		                               obj->internal.path,
-		                               nm_interface_info_device_statistics.parent.name,
-		                               "PropertiesChanged",
-		                               g_variant_new ("(@a{sv})",
-		                                              device_statistics_args),
-		                               NULL);
+		n_signals++;
+		_emit_signal (self,
+		              obj->internal.path,
+		              nm_interface_info_device_statistics.parent.name,
+		              "PropertiesChanged",
+		              g_variant_new ("(@a{sv})",
+		                             device_statistics_args));
 		g_variant_unref (device_statistics_args);
 	}
 
@@ -1290,16 +1828,163 @@ _nm_dbus_manager_obj_notify (NMDBusObject *obj,
 			const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info (reg_data);
 
 			if (interface_info->legacy_property_changed) {
-				g_dbus_connection_emit_signal (priv->main_dbus_connection,
-				                               NULL,
-				                               obj->internal.path,
-				                               interface_info->parent.name,
-				                               "PropertiesChanged",
-				                               args,
-				                               NULL);
+				n_signals += _emit_properties_changed_signal (self,
+				                                              interface_info,
+				                                              obj->internal.path,
+				                                              interface_info->parent.name,
+				                                              args);
 			}
 		}
 	}
+
+	return n_signals;
+}
+
+/* Drops the cached values of the changed properties, so that Get, GetAll and
+ * GetManagedObjects return the new values right away, even while the
+ * PropertiesChanged signal is still queued. */
+static void
+_obj_properties_invalidate (NMDBusObject *obj,
+                            guint n_pspecs,
+                            const GParamSpec *const*pspecs)
+{
+	RegistrationData *reg_data;
+	guint p;
+
+	c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+		for (p = 0; p < n_pspecs; p++) {
+			PropertyCacheData *cache;
+			guint idx;
+
+			idx = GPOINTER_TO_UINT (g_hash_table_lookup (reg_data->property_index->idx_by_pspec, pspecs[p]));
+			if (idx == 0)
+				continue;
+
+			cache = &reg_data->property_cache[idx - 1];
+			if (!cache->notify_pending) {
+				cache->notify_pending = TRUE;
+				cache->value_notified = g_steal_pointer (&cache->value);
+			} else
+				nm_clear_g_variant (&cache->value);
+		}
+	}
+
+	nm_clear_g_variant (&obj->internal.interfaces_and_properties);
+}
+
+/* Emits the queued property changes of all objects. This must happen
+ * before any other signal, so that clients see the signals in the
+ * same order as the changes happened. */
+static void
+_obj_notify_flush (NMDBusManager *self)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+	struct _NMDBusObjectInternal *internal;
+	guint n_objects = 0;
+	guint n_signals = 0;
+	guint n_pending;
+
+	nm_clear_g_source (&priv->notify_idle_id);
+
+	if (c_list_is_empty (&priv->notify_lst_head))
+		return;
+
+	n_pending = priv->notify_n_pending;
+	priv->notify_n_pending = 0;
+
+	while ((internal = c_list_first_entry (&priv->notify_lst_head, struct _NMDBusObjectInternal, notify_lst))) {
+		NMDBusObject *obj = (NMDBusObject *) (((char *) internal) - G_STRUCT_OFFSET (NMDBusObject, internal));
+		gs_unref_ptrarray GPtrArray *pspecs = NULL;
+
+		nm_assert (NM_IS_DBUS_OBJECT (obj));
+
+		c_list_unlink (&internal->notify_lst);
+		pspecs = g_steal_pointer (&internal->notify_pspecs);
+
+		/* the property values are only read now. Multiple changes of the same
+		 * property result in one notification with the latest value. */
+		n_signals += _obj_emit_properties_changed (self,
+		                                           obj,
+		                                           pspecs->len,
+		                                           (const GParamSpec *const*) pspecs->pdata);
+		n_objects++;
+	}
+
+	_LOGT ("notify: emitted %u signals for %u objects (%u notifications)",
+	       n_signals, n_objects, n_pending);
+}
+
+static gboolean
+_obj_notify_flush_cb (gpointer user_data)
+{
+	NMDBusManager *self = user_data;
+
+	NM_DBUS_MANAGER_GET_PRIVATE (self)->notify_idle_id = 0;
+	_obj_notify_flush (self);
+	return G_SOURCE_REMOVE;
+}
+
+void
+_nm_dbus_manager_obj_notify (NMDBusObject *obj,
+                             guint n_pspecs,
+                             const GParamSpec *const*pspecs)
+{
+	NMDBusManager *self;
+	NMDBusManagerPrivate *priv;
+	GPtrArray *queued;
+	guint i, j;
+
+	nm_assert (NM_IS_DBUS_OBJECT (obj));
+	nm_assert (obj->internal.path);
+	nm_assert (NM_IS_DBUS_MANAGER (obj->internal.bus_manager));
+	nm_assert (!c_list_is_empty (&obj->internal.objects_lst));
+
+	self = obj->internal.bus_manager;
+	priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+
+	nm_assert (!priv->started || priv->objmgr_registration_id != 0);
+	nm_assert (priv->objmgr_registration_id == 0 || priv->main_dbus_connection);
+	nm_assert (c_list_is_empty (&obj->internal.registration_lst_head) != priv->started);
+
+	if (G_UNLIKELY (!priv->started))
+		return;
+
+	if (   G_UNLIKELY (priv->shutting_down)
+	    || (   priv->pending_invocations
+	        && g_hash_table_size (priv->pending_invocations) > 0)) {
+		/* during shutdown, the mainloop might not run anymore. And while
+		 * a method call is pending, the reply must come after the change.
+		 * Don't delay the signals. */
+		_obj_notify_flush (self);
+		_obj_properties_invalidate (obj, n_pspecs, pspecs);
+		_obj_emit_properties_changed (self, obj, n_pspecs, pspecs);
+		return;
+	}
+
+	_obj_properties_invalidate (obj, n_pspecs, pspecs);
+
+	/* Instead of emitting the signals right away, merge the changes of
+	 * all notifications until we get back to the mainloop. */
+	queued = obj->internal.notify_pspecs;
+	if (!queued) {
+		queued = g_ptr_array_sized_new (NM_MAX (n_pspecs, 4u));
+		obj->internal.notify_pspecs = queued;
+		c_list_link_tail (&priv->notify_lst_head, &obj->internal.notify_lst);
+	}
+
+	for (i = 0; i < n_pspecs; i++) {
+		for (j = 0; j < queued->len; j++) {
+			if (queued->pdata[j] == pspecs[i])
+				break;
+		}
+		if (j == queued->len)
+			g_ptr_array_add (queued, (gpointer) pspecs[i]);
+	}
+
+	priv->notify_n_pending++;
+
+	if (!priv->notify_idle_id)
+		priv->notify_idle_id = g_idle_add_full (G_PRIORITY_DEFAULT, _obj_notify_flush_cb, self, NULL);
 }
 
 void
@@ -1324,13 +2009,13 @@ _nm_dbus_manager_obj_emit_signal (NMDBusObject *obj,
 		return;
 	}
 
-	g_dbus_connection_emit_signal (priv->main_dbus_connection,
-	                               NULL,
-	                               obj->internal.path,
-	                               interface_info->parent.name,
-	                               signal_info->name,
-	                               args,
-	                               NULL);
+	_obj_notify_flush (self);
+
+	_emit_signal (self,
+	              obj->internal.path,
+	              interface_info->parent.name,
+	              signal_info->name,
+	              args);
 }
 
 /*****************************************************************************/
@@ -1359,18 +2044,24 @@ _obj_collect_properties_per_interface (NMDBusObject *obj,
 	return builder;
 }
 
-static GVariantBuilder *
-_obj_collect_properties_all (NMDBusObject *obj,
-                             GVariantBuilder *builder)
+/* Returns all interfaces and properties of @obj. The value is cached
+ * until one of the properties changes, so that GetManagedObjects doesn't
+ * need to serialize all objects anew. */
+static GVariant *
+_obj_get_interfaces_and_properties (NMDBusObject *obj)
 {
 	RegistrationData *reg_data;
+	GVariantBuilder builder;
 
-	g_variant_builder_init (builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+	if (obj->internal.interfaces_and_properties)
+		return obj->internal.interfaces_and_properties;
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
 
 	c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
 		GVariantBuilder properties_builder;
 
-		g_variant_builder_add (builder,
+		g_variant_builder_add (&builder,
 		                       "{sa{sv}}",
 		                       _reg_data_get_interface_info (reg_data)->parent.name,
 		                       _obj_collect_properties_per_interface (obj,
@@ -1378,7 +2069,8 @@ _obj_collect_properties_all (NMDBusObject *obj,
 		                                                              &properties_builder));
 	}
 
-	return builder;
+	obj->internal.interfaces_and_properties = g_variant_ref_sink (g_variant_builder_end (&builder));
+	return obj->internal.interfaces_and_properties;
 }
 
 static void
@@ -1408,20 +2100,21 @@ dbus_vtable_objmgr_method_call (GDBusConnection *connection,
 		return;
 	}
 
+	/* the reply should contain the current state. Emit the pending changes
+	 * first, this also updates the cached values. */
+	_obj_notify_flush (self);
+
 	g_variant_builder_init (&array_builder, G_VARIANT_TYPE ("a{oa{sa{sv}}}"));
 	c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst) {
-		GVariantBuilder interfaces_builder;
-
 		/* note that we are called on an idle handler. Hence, all properties are
 		 * supposed to be in a consistent state. That is true, if you always
 		 * g_object_thaw_notify() before returning to the mainloop. Keeping
 		 * signals frozen between while returning from the current call stack
 		 * is anyway a very fragile thing, easy to get wrong. Don't do that. */
 		g_variant_builder_add (&array_builder,
-		                       "{oa{sa{sv}}}",
+		                       "{o@a{sa{sv}}}",
 		                       obj->internal.path,
-		                       _obj_collect_properties_all (obj,
-		                                                    &interfaces_builder));
+		                       _obj_get_interfaces_and_properties (obj));
 	}
 	g_dbus_method_invocation_return_value (invocation,
 	                                       g_variant_new ("(a{oa{sa{sv}}})",
@@ -1589,6 +2282,10 @@ nm_dbus_manager_stop (NMDBusManager *self)
 
 	priv->shutting_down = TRUE;
 
+	/* from now on, property changes are emitted right away. */
+	if (priv->started)
+		_obj_notify_flush (self);
+
 	/* during shutdown we also clear the set-property-handler. It's no longer
 	 * possible to set a property, because doing so would require authorization,
 	 * which is async, which is just complicated to get right. No more property
@@ -1605,6 +2302,202 @@ nm_dbus_manager_is_stopping (NMDBusManager *self)
 
 /*****************************************************************************/
 
+void
+nm_dbus_manager_set_filter_signals (NMDBusManager *self,
+                                    gboolean filter_signals)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+
+	if (priv->filter_signals == (!!filter_signals))
+		return;
+
+	priv->filter_signals = filter_signals;
+	_LOGD ("%s filtering of signals for high-volume interfaces",
+	       filter_signals ? "enable" : "disable");
+}
+
+static void
+_subscriber_free (gpointer data)
+{
+	Subscriber *subscriber = data;
+
+	nm_clear_g_cancellable (&subscriber->name_owner_cancellable);
+	nm_clear_g_dbus_connection_signal (NM_DBUS_MANAGER_GET_PRIVATE (subscriber->self)->main_dbus_connection,
+	                                   &subscriber->name_owner_changed_id);
+	g_strfreev (subscriber->interfaces);
+	g_free (subscriber->name);
+	g_slice_free (Subscriber, subscriber);
+}
+
+#define SUBSCRIBER_INTERFACES_MAX 16
+#define SUBSCRIBERS_MAX           256
+
+static void
+_subscriber_remove (NMDBusManager *self, const char *name)
+{
+	NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+
+	if (   !priv->subscribers
+	    || !g_hash_table_remove (priv->subscribers, name))
+		return;
+
+	_LOGT ("subscriptions: remove %s", name);
+
+	if (   priv->subscribers_overflow
+	    && g_hash_table_size (priv->subscribers) < SUBSCRIBERS_MAX) {
+		priv->subscribers_overflow = FALSE;
+		_LOGI ("subscriptions: less than %d subscribers, filter signals again",
+		       SUBSCRIBERS_MAX);
+	}
+}
+
+static void
+_subscriber_name_owner_changed_cb (GDBusConnection *dbus_connection,
+                                   const char *sender_name,
+                                   const char *object_path,
+                                   const char *interface_name,
+                                   const char *signal_name,
+                                   GVariant *parameters,
+                                   gpointer user_data)
+{
+	NMDBusManager *self = user_data;
+	const char *name;
+	const char *new_owner;
+
+	if (!g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(sss)")))
+		return;
+
+	g_variant_get (parameters, "(&s&s&s)", &name, NULL, &new_owner);
+	if (!new_owner[0])
+		_subscriber_remove (self, name);
+}
+
+static void
+_subscriber_get_name_owner_cb (const char *name_owner,
+                               GError *error,
+                               gpointer user_data)
+{
+	Subscriber *subscriber;
+
+	if (nm_utils_error_is_cancelled (error))
+		return;
+
+	subscriber = user_data;
+	g_clear_object (&subscriber->name_owner_cancellable);
+
+	if (!name_owner) {
+		/* the client is already gone. */
+		_subscriber_remove (subscriber->self, subscriber->name);
+	}
+}
+
+/**
+ * nm_dbus_manager_subscribe_interfaces:
+ * @self: the #NMDBusManager
+ * @sender: the unique name of the client
+ * @interfaces: the names of the interfaces that the client is
+ *   interested in. An empty list drops the subscription.
+ * @error: location to store the error
+ *
+ * Replaces the subscriptions of the client. The client receives the
+ * PropertiesChanged signals of these high-volume interfaces, also when signal
+ * filtering is enabled. The subscription ends when the client disconnects
+ * from the bus.
+ *
+ * A client can subscribe to at most %SUBSCRIBER_INTERFACES_MAX interfaces.
+ * At most %SUBSCRIBERS_MAX clients can subscribe. Once a client was
+ * rejected, filtering is disabled and all signals are broadcast, until the
+ * number of subscribers drops again.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nm_dbus_manager_subscribe_interfaces (NMDBusManager *self,
+                                      const char *sender,
+                                      const char *const*interfaces,
+                                      GError **error)
+{
+	NMDBusManagerPrivate *priv;
+	Subscriber *subscriber;
+
+	g_return_val_if_fail (NM_IS_DBUS_MANAGER (self), FALSE);
+	g_return_val_if_fail (sender && sender[0] == ':', FALSE);
+
+	priv = NM_DBUS_MANAGER_GET_PRIVATE (self);
+
+	if (NM_PTRARRAY_LEN (interfaces) > SUBSCRIBER_INTERFACES_MAX) {
+		g_set_error (error,
+		             G_DBUS_ERROR,
+		             G_DBUS_ERROR_LIMITS_EXCEEDED,
+		             "Cannot subscribe to more than %d interfaces",
+		             SUBSCRIBER_INTERFACES_MAX);
+		return FALSE;
+	}
+
+	if (!priv->main_dbus_connection)
+		return TRUE;
+
+	if (!interfaces || !interfaces[0]) {
+		_subscriber_remove (self, sender);
+		return TRUE;
+	}
+
+	if (!priv->subscribers)
+		priv->subscribers = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, _subscriber_free);
+
+	subscriber = g_hash_table_lookup (priv->subscribers, sender);
+	if (!subscriber) {
+		if (g_hash_table_size (priv->subscribers) >= SUBSCRIBERS_MAX) {
+			/* don't track an unbounded number of clients. The rejected
+			 * client still needs its signals, so broadcast them until the
+			 * number of subscribers drops. */
+			if (!priv->subscribers_overflow) {
+				priv->subscribers_overflow = TRUE;
+				_LOGW ("subscriptions: more than %d subscribers, stop filtering signals",
+				       SUBSCRIBERS_MAX);
+			}
+			g_set_error (error,
+			             G_DBUS_ERROR,
+			             G_DBUS_ERROR_LIMITS_EXCEEDED,
+			             "Cannot have more than %d subscribers",
+			             SUBSCRIBERS_MAX);
+			return FALSE;
+		}
+
+		subscriber = g_slice_new0 (Subscriber);
+		subscriber->self = self;
+		subscriber->name = g_strdup (sender);
+		subscriber->name_owner_changed_id = nm_dbus_connection_signal_subscribe_name_owner_changed (priv->main_dbus_connection,
+		                                                                                            subscriber->name,
+		                                                                                            _subscriber_name_owner_changed_cb,
+		                                                                                            self,
+		                                                                                            NULL);
+
+		/* the client might have disconnected before we subscribed to
+		 * NameOwnerChanged. Check that it is still there. */
+		subscriber->name_owner_cancellable = g_cancellable_new ();
+		nm_dbus_connection_call_get_name_owner (priv->main_dbus_connection,
+		                                        subscriber->name,
+		                                        -1,
+		                                        subscriber->name_owner_cancellable,
+		                                        _subscriber_get_name_owner_cb,
+		                                        subscriber);
+		g_hash_table_insert (priv->subscribers, subscriber->name, subscriber);
+	}
+
+	g_strfreev (subscriber->interfaces);
+	subscriber->interfaces = g_strdupv ((char **) interfaces);
+
+	if (_LOGT_ENABLED ()) {
+		gs_free char *str = g_strjoinv (",", subscriber->interfaces);
+
+		_LOGT ("subscriptions: %s subscribes to %s", sender, str);
+	}
+	return TRUE;
+}
+
+/*****************************************************************************/
+
 static void
 nm_dbus_manager_init (NMDBusManager *self)
 {
@@ -1612,10 +2505,12 @@ nm_dbus_manager_init (NMDBusManager *self)
 
 	c_list_init (&priv->private_servers_lst_head);
 	c_list_init (&priv->objects_lst_head);
+	c_list_init (&priv->notify_lst_head);
 
 	priv->objects_by_path = g_hash_table_new ((GHashFunc) _objects_by_path_hash, (GEqualFunc) _objects_by_path_equal);
 
 	c_list_init (&priv->caller_info_lst_head);
+	priv->caller_infos = g_hash_table_new (nm_str_hash, g_str_equal);
 }
 
 static void
@@ -1630,6 +2525,22 @@ dispose (GObject *object)
 	 * expect any remaining objects. */
 	nm_assert (!priv->objects_by_path || g_hash_table_size (priv->objects_by_path) == 0);
 	nm_assert (c_list_is_empty (&priv->objects_lst_head));
+	nm_assert (c_list_is_empty (&priv->notify_lst_head));
+
+	nm_clear_g_source (&priv->notify_idle_id);
+
+	if (priv->pending_invocations) {
+		GHashTableIter iter;
+		GObject *invocation;
+
+		g_hash_table_iter_init (&iter, priv->pending_invocations);
+		while (g_hash_table_iter_next (&iter, (gpointer *) &invocation, NULL))
+			g_object_weak_unref (invocation, _invocation_finalized_cb, self);
+		nm_clear_pointer (&priv->pending_invocations, g_hash_table_destroy);
+	}
+
+	nm_clear_pointer (&priv->property_indexes, g_hash_table_destroy);
+	nm_clear_pointer (&priv->subscribers, g_hash_table_destroy);
 
 	g_clear_pointer (&priv->objects_by_path, g_hash_table_destroy);
 
@@ -1641,12 +2552,13 @@ dispose (GObject *object)
 		                                     nm_steal_int (&priv->objmgr_registration_id));
 	}
 
+	while ((caller_info = c_list_first_entry (&priv->caller_info_lst_head, CallerInfo, caller_info_lst)))
+		_caller_info_free (self, caller_info);
+	nm_clear_pointer (&priv->caller_infos, g_hash_table_destroy);
+
 	g_clear_object (&priv->main_dbus_connection);
 
 	G_OBJECT_CLASS (nm_dbus_manager_parent_class)->dispose (object);
-
-	while ((caller_info = c_list_first_entry (&priv->caller_info_lst_head, CallerInfo, caller_info_lst)))
-		_caller_info_free (caller_info);
 }
 
 static void
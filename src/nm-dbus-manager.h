@@ -49,6 +49,14 @@ void nm_dbus_manager_stop (NMDBusManager *self);
 
 gboolean nm_dbus_manager_is_stopping (NMDBusManager *self);
 
+void nm_dbus_manager_set_filter_signals (NMDBusManager *self,
+                                         gboolean filter_signals);
+
+gboolean nm_dbus_manager_subscribe_interfaces (NMDBusManager *self,
+                                               const char *sender,
+                                               const char *const*interfaces,
+                                               GError **error);
+
 gpointer nm_dbus_manager_lookup_object (NMDBusManager *self, const char *path);
 
 void _nm_dbus_manager_obj_export (NMDBusObject *obj);
@@ -88,6 +96,9 @@ void nm_dbus_manager_private_server_register (NMDBusManager *self,
                                               const char *path,
                                               const char *tag);
 
+void nm_dbus_manager_private_client_server_register (NMDBusManager *self,
+                                                     const char *path);
+
 NMAuthSubject *nm_dbus_manager_new_auth_subject_from_context (GDBusMethodInvocation *context);
 
 NMAuthSubject *nm_dbus_manager_new_auth_subject_from_message (GDBusConnection *connection,
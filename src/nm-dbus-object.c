@@ -225,6 +225,7 @@ nm_dbus_object_init (NMDBusObject *self)
 {
 	c_list_init (&self->internal.objects_lst);
 	c_list_init (&self->internal.registration_lst_head);
+	c_list_init (&self->internal.notify_lst);
 	self->internal.bus_manager = nm_g_object_ref (nm_dbus_manager_get ());
 }
 
@@ -270,6 +271,10 @@ dispose (GObject *object)
 		nm_dbus_object_unexport (self);
 	}
 
+	nm_assert (c_list_is_empty (&self->internal.notify_lst));
+	nm_assert (!self->internal.notify_pspecs);
+	nm_assert (!self->internal.interfaces_and_properties);
+
 	G_OBJECT_CLASS (nm_dbus_object_parent_class)->dispose (object);
 
 	g_clear_object (&self->internal.bus_manager);
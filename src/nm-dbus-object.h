@@ -73,6 +73,14 @@ struct _NMDBusObjectInternal {
 	CList objects_lst;
 	CList registration_lst_head;
 
+	/* property changes are queued and emitted by NMDBusManager later. */
+	CList notify_lst;
+	GPtrArray *notify_pspecs;
+
+	/* the cached "a{sa{sv}}" value with all interfaces and properties, as
+	 * used by GetManagedObjects. */
+	GVariant *interfaces_and_properties;
+
 	/* we perform asynchronous operation on exported objects. For example, we receive
 	 * a Set property call, and asynchronously validate the operation. We must make
 	 * sure that when the authentication is complete, that we are still looking at
@@ -122,6 +122,11 @@ typedef struct _NMDBusInterfaceInfoExtended {
 	/* Whether the interface has a legacy property changed signal (@nm_signal_info_property_changed_legacy).
 	 * New interfaces should not use this. */
 	bool legacy_property_changed:1;
+
+	/* Whether the interface emits many property changes. If the signal filtering
+	 * is enabled, the PropertiesChanged signals of such an interface are only sent
+	 * to clients that subscribed to it. */
+	bool high_volume:1;
 } NMDBusInterfaceInfoExtended;
 
 extern const GDBusSignalInfo nm_signal_info_property_changed_legacy;
@@ -3385,6 +3385,7 @@ static const NMDBusInterfaceInfoExtended interface_info_ip4_config = {
 		),
 	),
 	.legacy_property_changed = TRUE,
+	.high_volume = TRUE,
 };
 
 static void
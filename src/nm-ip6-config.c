@@ -2794,6 +2794,7 @@ static const NMDBusInterfaceInfoExtended interface_info_ip6_config = {
 		),
 	),
 	.legacy_property_changed = TRUE,
+	.high_volume = TRUE,
 };
 
 static void
@@ -165,6 +165,10 @@ typedef struct {
 	NMRfkillManager *rfkill_mgr;
 
 	CList link_cb_lst;
+	GHashTable *link_cb_idx;
+	guint link_cb_idle_id;
+	guint64 link_cb_n_received;
+	guint64 link_cb_n_dispatched;
 
 	NMCheckpointManager *checkpoint_mgr;
 
@@ -178,6 +182,7 @@ typedef struct {
 	NMAuthManager *auth_mgr;
 
 	GHashTable *device_route_metrics;
+	GHashTable *device_route_metric_ranges;
 
 	CList auth_lst_head;
 
@@ -565,10 +570,24 @@ _async_op_complete_ac_auth_cb (NMActiveConnection *active,
 
 /*****************************************************************************/
 
+/* A device bumps its default route metric at most this many points above
+ * the aspired metric. */
+#define DEVICE_ROUTE_METRIC_BUMP_MAX 50
+
+typedef struct {
+	guint32 aspired_metric;
+
+	/* For each offset of the effective metric from @aspired_metric, the list
+	 * of DeviceRouteMetricData that reserve the range
+	 * [aspired_metric, aspired_metric + offset]. */
+	CList effective_lst_heads[DEVICE_ROUTE_METRIC_BUMP_MAX + 1];
+} DeviceRouteMetricRange;
+
 typedef struct {
 	int ifindex;
 	guint32 aspired_metric;
 	guint32 effective_metric;
+	CList range_lst;
 } DeviceRouteMetricData;
 
 static DeviceRouteMetricData *
@@ -584,14 +603,25 @@ _device_route_metric_data_new (int ifindex, guint32 aspired_metric, guint32 effe
 	 */
 	nm_assert (aspired_metric > 0);
 	nm_assert (effective_metric == 0 || aspired_metric <= effective_metric);
+	nm_assert (effective_metric == 0 || effective_metric - aspired_metric <= DEVICE_ROUTE_METRIC_BUMP_MAX);
 
 	data = g_slice_new0 (DeviceRouteMetricData);
 	data->ifindex = ifindex;
 	data->aspired_metric = aspired_metric;
 	data->effective_metric = effective_metric ?: aspired_metric;
+	c_list_init (&data->range_lst);
 	return data;
 }
 
+static void
+_device_route_metric_data_free (gpointer user_data)
+{
+	DeviceRouteMetricData *data = user_data;
+
+	c_list_unlink_stale (&data->range_lst);
+	g_slice_free (DeviceRouteMetricData, data);
+}
+
 static guint
 _device_route_metric_data_by_ifindex_hash (gconstpointer p)
 {
@@ -612,6 +642,116 @@ _device_route_metric_data_by_ifindex_equal (gconstpointer pa, gconstpointer pb)
 	return a->ifindex == b->ifindex;
 }
 
+static guint
+_device_route_metric_range_hash (gconstpointer p)
+{
+	const DeviceRouteMetricRange *range = p;
+	NMHashState h;
+
+	nm_hash_init (&h, 2376104063);
+	nm_hash_update_vals (&h, range->aspired_metric);
+	return nm_hash_complete (&h);
+}
+
+static gboolean
+_device_route_metric_range_equal (gconstpointer pa, gconstpointer pb)
+{
+	const DeviceRouteMetricRange *a = pa;
+	const DeviceRouteMetricRange *b = pb;
+
+	return a->aspired_metric == b->aspired_metric;
+}
+
+static void
+_device_route_metric_data_add (NMManager *self,
+                               DeviceRouteMetricData *data)
+{
+	NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE (self);
+	DeviceRouteMetricRange *range;
+	DeviceRouteMetricRange range_lookup;
+	guint i;
+
+	nm_assert (c_list_is_empty (&data->range_lst));
+	nm_assert (data->effective_metric - data->aspired_metric <= DEVICE_ROUTE_METRIC_BUMP_MAX);
+
+	range_lookup.aspired_metric = data->aspired_metric;
+	range = g_hash_table_lookup (priv->device_route_metric_ranges, &range_lookup);
+	if (!range) {
+		range = g_slice_new (DeviceRouteMetricRange);
+		range->aspired_metric = data->aspired_metric;
+		for (i = 0; i < G_N_ELEMENTS (range->effective_lst_heads); i++)
+			c_list_init (&range->effective_lst_heads[i]);
+		if (!g_hash_table_add (priv->device_route_metric_ranges, range))
+			nm_assert_not_reached ();
+	}
+
+	if (!g_hash_table_add (priv->device_route_metrics, data))
+		nm_assert_not_reached ();
+
+	c_list_link_tail (&range->effective_lst_heads[data->effective_metric - data->aspired_metric],
+	                  &data->range_lst);
+}
+
+/* Returns the highest effective metric of all reservations whose range
+ * [aspired_metric, effective_metric] contains @metric, or zero if @metric
+ * is not reserved by any device.
+ *
+ * A range spans at most DEVICE_ROUTE_METRIC_BUMP_MAX points, so only ranges
+ * with an aspired metric close below @metric need to be looked at. This
+ * bounds the work independent of the number of reservations. */
+static guint32
+_device_route_metric_find_reserved (NMManager *self,
+                                    guint32 metric,
+                                    gboolean prune_stale)
+{
+	NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE (self);
+	DeviceRouteMetricRange range_lookup;
+	guint32 result = 0;
+
+	nm_assert (metric > 0);
+
+	range_lookup.aspired_metric =   metric > DEVICE_ROUTE_METRIC_BUMP_MAX
+	                              ? metric - DEVICE_ROUTE_METRIC_BUMP_MAX
+	                              : 1u;
+	for (;; range_lookup.aspired_metric++) {
+		DeviceRouteMetricRange *range;
+		int offset;
+		int offset_min;
+
+		range = g_hash_table_lookup (priv->device_route_metric_ranges, &range_lookup);
+		if (range) {
+			offset_min = metric - range->aspired_metric;
+			offset = NM_MIN ((guint32) DEVICE_ROUTE_METRIC_BUMP_MAX,
+			                 G_MAXUINT32 - range->aspired_metric);
+			for (; offset >= offset_min; offset--) {
+				DeviceRouteMetricData *d2;
+				DeviceRouteMetricData *d2_safe;
+				gboolean found = FALSE;
+
+				c_list_for_each_entry_safe (d2, d2_safe, &range->effective_lst_heads[offset], range_lst) {
+					if (   prune_stale
+					    && !nm_platform_link_get (priv->platform, d2->ifindex)) {
+						/* the metric seems taken, but there is no such interface. This entry
+						 * is stale, forget about it. */
+						g_hash_table_remove (priv->device_route_metrics, d2);
+						continue;
+					}
+					found = TRUE;
+					break;
+				}
+				if (found) {
+					result = NM_MAX (result, range->aspired_metric + (guint32) offset);
+					break;
+				}
+			}
+		}
+		if (range_lookup.aspired_metric == metric)
+			break;
+	}
+
+	return result;
+}
+
 static guint32
 _device_route_metric_get (NMManager *self,
                           int ifindex,
@@ -652,10 +792,14 @@ _device_route_metric_get (NMManager *self,
 		const GHashTable *h;
 		const NMConfigDeviceStateData *device_state;
 
+		priv->device_route_metric_ranges = g_hash_table_new_full (_device_route_metric_range_hash,
+		                                                          _device_route_metric_range_equal,
+		                                                          NULL,
+		                                                          nm_g_slice_free_fcn (DeviceRouteMetricRange));
 		priv->device_route_metrics = g_hash_table_new_full (_device_route_metric_data_by_ifindex_hash,
 		                                                    _device_route_metric_data_by_ifindex_equal,
 		                                                    NULL,
-		                                                    nm_g_slice_free_fcn (DeviceRouteMetricData));
+		                                                    _device_route_metric_data_free);
 		cleaned = TRUE;
 
 		/* we need to pre-populate the cache for all (still existing) devices from the state-file */
@@ -665,6 +809,8 @@ _device_route_metric_get (NMManager *self,
 
 		g_hash_table_iter_init (&h_iter, (GHashTable *) h);
 		while (g_hash_table_iter_next (&h_iter, NULL, (gpointer *) &device_state)) {
+			guint32 aspired_metric;
+
 			if (!device_state->route_metric_default_effective)
 				continue;
 			if (!nm_platform_link_get (priv->platform, device_state->ifindex)) {
@@ -673,11 +819,18 @@ _device_route_metric_get (NMManager *self,
 				 * hence we skip it. */
 				continue;
 			}
-			if (!g_hash_table_add (priv->device_route_metrics,
-			                       _device_route_metric_data_new (device_state->ifindex,
-			                                                      device_state->route_metric_default_aspired,
-			                                                      device_state->route_metric_default_effective)))
-				nm_assert_not_reached ();
+
+			/* we never bump the metric by more than DEVICE_ROUTE_METRIC_BUMP_MAX. If the
+			 * state file claims otherwise, keep the effective metric but shrink the
+			 * reserved range. */
+			aspired_metric = device_state->route_metric_default_aspired;
+			if (device_state->route_metric_default_effective - aspired_metric > DEVICE_ROUTE_METRIC_BUMP_MAX)
+				aspired_metric = device_state->route_metric_default_effective - DEVICE_ROUTE_METRIC_BUMP_MAX;
+
+			_device_route_metric_data_add (self,
+			                               _device_route_metric_data_new (device_state->ifindex,
+			                                                              aspired_metric,
+			                                                              device_state->route_metric_default_effective));
 		}
 	}
 
@@ -716,31 +869,20 @@ initited:
 
 	data = _device_route_metric_data_new (ifindex, nm_device_get_route_metric_default (device_type), 0);
 
-	/* unfortunately, there is no stright forward way to lookup all reserved metrics.
-	 * Note, that we don't only have to know which metrics are currently reserved,
+	/* Note, that we don't only have to know which metrics are currently reserved,
 	 * but also, which metrics are now seemingly un-used but caused another reserved
-	 * metric to be bumped. Hence, the naive O(n^2) search :(
+	 * metric to be bumped. That is, every device reserves the entire range from its
+	 * aspired_metric to its effective_metric.
 	 *
-	 * Well, technically, since we limit bumping the metric to 50, this entire
-	 * loop runs at most 50 times, so it's still O(n). Let's just say, it's not
-	 * very efficient. */
-again:
-	g_hash_table_iter_init (&h_iter, priv->device_route_metrics);
-	while (g_hash_table_iter_next (&h_iter, NULL, (gpointer *) &d2)) {
-		if (   data->effective_metric < d2->aspired_metric
-		    || data->effective_metric > d2->effective_metric) {
-			/* no overlap. Skip. */
-			continue;
-		}
-		if (   !cleaned
-		    && !nm_platform_link_get (priv->platform, d2->ifindex)) {
-			/* the metric seems taken, but there is no such interface. This entry
-			 * is stale, forget about it. */
-			g_hash_table_iter_remove (&h_iter);
-			continue;
-		}
+	 * Search the lowest metric that is not inside any such range. Each lookup
+	 * jumps past the highest range that overlaps the candidate metric, and we
+	 * limit bumping the metric to DEVICE_ROUTE_METRIC_BUMP_MAX. */
+	while (TRUE) {
+		metric = _device_route_metric_find_reserved (self, data->effective_metric, !cleaned);
+		if (metric == 0)
+			break;
 
-		if (d2->effective_metric == G_MAXUINT32) {
+		if (metric == G_MAXUINT32) {
 			/* we cannot bump the metric any further. Done.
 			 *
 			 * Actually, this can currently not happen because the aspired_metric
@@ -750,27 +892,25 @@ again:
 			break;
 		}
 
-		if (d2->effective_metric - data->aspired_metric >= 50) {
+		if (metric - data->aspired_metric >= DEVICE_ROUTE_METRIC_BUMP_MAX) {
 			/* as one active interface reserves an entire range of metrics
 			 * (from aspired_metric to effective_metric), that means if you
 			 * alternatingly activate two interfaces, their metric will
 			 * bump each other.
 			 *
 			 * Limit this, bump the metric at most 50 points. */
-			data->effective_metric = data->aspired_metric + 50;
+			data->effective_metric = data->aspired_metric + DEVICE_ROUTE_METRIC_BUMP_MAX;
 			break;
 		}
 
 		/* bump the metric, and search again. */
-		data->effective_metric = d2->effective_metric + 1;
-		goto again;
+		data->effective_metric = metric + 1;
 	}
 
 	_LOGT (LOGD_DEVICE, "default-route-metric: ifindex %d reserves metric %u (aspired %u)",
 	       data->ifindex, data->effective_metric, data->aspired_metric);
 
-	if (!g_hash_table_add (priv->device_route_metrics, data))
-		nm_assert_not_reached ();
+	_device_route_metric_data_add (self, data);
 
 out:
 	NM_SET_OUT (out_aspired_metric, data->aspired_metric);
@@ -3397,23 +3537,17 @@ add:
 }
 
 typedef struct {
-	CList lst;
-	NMManager *self;
+	/* must be the first field, the struct is hashed by nm_pint_hash(). */
 	int ifindex;
-	guint idle_id;
+	CList lst;
 } PlatformLinkCbData;
 
-static gboolean
-_platform_link_cb_idle (PlatformLinkCbData *data)
+static void
+_platform_link_dispatch (NMManager *self, int ifindex)
 {
-	int ifindex = data->ifindex;
-	NMManager *self = data->self;
 	NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE (self);
 	const NMPlatformLink *plink;
 
-	c_list_unlink_stale (&data->lst);
-	g_slice_free (PlatformLinkCbData, data);
-
 	plink = nm_platform_link_get (priv->platform, ifindex);
 	if (plink) {
 		const NMPObject *plink_keep_alive = nmp_object_ref (NMP_OBJECT_UP_CAST (plink));
@@ -3442,6 +3576,45 @@ _platform_link_cb_idle (PlatformLinkCbData *data)
 			}
 		}
 	}
+}
+
+static gboolean
+_platform_link_cb_idle (gpointer user_data)
+{
+	NMManager *self = user_data;
+	NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE (self);
+	CList batch_lst_head = C_LIST_INIT (batch_lst_head);
+	PlatformLinkCbData *data;
+	guint n_dispatched = 0;
+
+	priv->link_cb_idle_id = 0;
+
+	/* Handle all links that changed since the last main loop iteration in
+	 * one pass, in the order in which they first changed. Events that arrive
+	 * while dispatching are handled in the next iteration. Until an entry is
+	 * dispatched, it stays in the index, so that further events for the same
+	 * ifindex are merged into it. We always look at the latest state in the
+	 * platform cache anyway. */
+	c_list_splice (&batch_lst_head, &priv->link_cb_lst);
+
+	while ((data = c_list_first_entry (&batch_lst_head, PlatformLinkCbData, lst))) {
+		int ifindex = data->ifindex;
+
+		c_list_unlink_stale (&data->lst);
+		if (!g_hash_table_remove (priv->link_cb_idx, data))
+			nm_assert_not_reached ();
+		g_slice_free (PlatformLinkCbData, data);
+
+		n_dispatched++;
+		_platform_link_dispatch (self, ifindex);
+	}
+
+	priv->link_cb_n_dispatched += n_dispatched;
+
+	_LOGT (LOGD_PLATFORM, "platform: dispatched %u link changes (%"G_GUINT64_FORMAT" events received, %"G_GUINT64_FORMAT" dispatched in total)",
+	       n_dispatched,
+	       priv->link_cb_n_received,
+	       priv->link_cb_n_dispatched);
 
 	return G_SOURCE_REMOVE;
 }
@@ -3465,11 +3638,21 @@ platform_link_cb (NMPlatform *platform,
 		self = NM_MANAGER (user_data);
 		priv = NM_MANAGER_GET_PRIVATE (self);
 
+		priv->link_cb_n_received++;
+
+		if (g_hash_table_contains (priv->link_cb_idx, &ifindex)) {
+			/* already queued. */
+			break;
+		}
+
 		data = g_slice_new (PlatformLinkCbData);
-		data->self = self;
 		data->ifindex = ifindex;
 		c_list_link_tail (&priv->link_cb_lst, &data->lst);
-		data->idle_id = g_idle_add ((GSourceFunc) _platform_link_cb_idle, data);
+		if (!g_hash_table_add (priv->link_cb_idx, data))
+			nm_assert_not_reached ();
+
+		if (!priv->link_cb_idle_id)
+			priv->link_cb_idle_id = g_idle_add (_platform_link_cb_idle, self);
 		break;
 	default:
 		break;
@@ -6362,6 +6545,51 @@ impl_manager_get_logging (NMDBusObject *obj,
 	                                                      nm_logging_domains_to_string ()));
 }
 
+static void
+impl_manager_subscribe_interfaces (NMDBusObject *obj,
+                                   const NMDBusInterfaceInfoExtended *interface_info,
+                                   const NMDBusMethodInfoExtended *method_info,
+                                   GDBusConnection *connection,
+                                   const char *sender,
+                                   GDBusMethodInvocation *invocation,
+                                   GVariant *parameters)
+{
+	gs_free const char **interfaces = NULL;
+	GError *error = NULL;
+	gsize i;
+
+	g_variant_get (parameters, "(^a&s)", &interfaces);
+
+	for (i = 0; interfaces[i]; i++) {
+		if (!g_dbus_is_interface_name (interfaces[i])) {
+			g_dbus_method_invocation_return_error (invocation,
+			                                       NM_MANAGER_ERROR,
+			                                       NM_MANAGER_ERROR_INVALID_ARGUMENTS,
+			                                       "Invalid interface name '%s'",
+			                                       interfaces[i]);
+			return;
+		}
+	}
+
+	if (!sender) {
+		g_dbus_method_invocation_return_error_literal (invocation,
+		                                               NM_MANAGER_ERROR,
+		                                               NM_MANAGER_ERROR_FAILED,
+		                                               "Subscriptions require a connection to the message bus");
+		return;
+	}
+
+	if (!nm_dbus_manager_subscribe_interfaces (nm_dbus_object_get_manager (obj),
+	                                           sender,
+	                                           interfaces,
+	                                           &error)) {
+		g_dbus_method_invocation_take_error (invocation, error);
+		return;
+	}
+
+	g_dbus_method_invocation_return_value (invocation, NULL);
+}
+
 typedef struct {
 	NMManager *self;
 	GDBusMethodInvocation *context;
@@ -7460,6 +7688,7 @@ nm_manager_init (NMManager *self)
 
 	c_list_init (&priv->auth_lst_head);
 	c_list_init (&priv->link_cb_lst);
+	priv->link_cb_idx = g_hash_table_new (nm_pint_hash, nm_pint_equals);
 	c_list_init (&priv->devices_lst_head);
 	c_list_init (&priv->active_connections_lst_head);
 	c_list_init (&priv->async_op_lst_head);
@@ -7718,13 +7947,14 @@ dispose (GObject *object)
 	g_signal_handlers_disconnect_by_func (priv->platform,
 	                                      G_CALLBACK (platform_link_cb),
 	                                      self);
+	nm_clear_g_source (&priv->link_cb_idle_id);
 	while ((iter = c_list_first (&priv->link_cb_lst))) {
 		PlatformLinkCbData *data = c_list_entry (iter, PlatformLinkCbData, lst);
 
-		g_source_remove (data->idle_id);
 		c_list_unlink_stale (&data->lst);
 		g_slice_free (PlatformLinkCbData, data);
 	}
+	g_clear_pointer (&priv->link_cb_idx, g_hash_table_destroy);
 
 	while ((iter = c_list_first (&priv->auth_lst_head)))
 		nm_auth_chain_destroy (nm_auth_chain_parent_lst_entry (iter));
@@ -7817,6 +8047,7 @@ dispose (GObject *object)
 	nm_clear_g_source (&priv->timestamp_update_id);
 
 	g_clear_pointer (&priv->device_route_metrics, g_hash_table_destroy);
+	g_clear_pointer (&priv->device_route_metric_ranges, g_hash_table_destroy);
 
 	G_OBJECT_CLASS (nm_manager_parent_class)->dispose (object);
 }
@@ -8066,6 +8297,15 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
 				),
 				.handle = impl_manager_checkpoint_adjust_rollback_timeout,
 			),
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"SubscribeInterfaces",
+					.in_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("interfaces", "as"),
+					),
+				),
+				.handle = impl_manager_subscribe_interfaces,
+			),
 		),
 		.signals = NM_DEFINE_GDBUS_SIGNAL_INFOS (
 			&nm_signal_info_property_changed_legacy,
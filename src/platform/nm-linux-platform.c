@@ -6981,6 +6981,13 @@ link_refresh (NMPlatform *platform, int ifindex)
 	return !!nm_platform_link_get_obj (platform, ifindex, TRUE);
 }
 
+static void
+link_refresh_all (NMPlatform *platform)
+{
+	do_request_all_no_delayed_actions (platform, DELAYED_ACTION_TYPE_REFRESH_ALL_LINKS);
+	delayed_action_handle_all (platform, FALSE);
+}
+
 static gboolean
 link_set_netns (NMPlatform *platform,
                 int ifindex,
@@ -9203,6 +9210,7 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 	platform_class->link_delete = link_delete;
 
 	platform_class->link_refresh = link_refresh;
+	platform_class->link_refresh_all = link_refresh_all;
 
 	platform_class->link_set_netns = link_set_netns;
 
@@ -1485,6 +1485,22 @@ nm_platform_link_refresh (NMPlatform *self, int ifindex)
 	return TRUE;
 }
 
+/**
+ * nm_platform_link_refresh_all:
+ * @self: platform instance
+ *
+ * Reload the cache for all links synchronously. This uses a single
+ * dump request, which is cheaper than refreshing many links one by one.
+ */
+void
+nm_platform_link_refresh_all (NMPlatform *self)
+{
+	_CHECK_SELF_VOID (self, klass);
+
+	if (klass->link_refresh_all)
+		klass->link_refresh_all (self);
+}
+
 int
 nm_platform_link_get_ifi_flags (NMPlatform *self,
                                 int ifindex,
@@ -984,6 +984,7 @@ typedef struct {
 	                 const NMPlatformLink **out_link);
 	gboolean (*link_delete) (NMPlatform *self, int ifindex);
 	gboolean (*link_refresh) (NMPlatform *self, int ifindex);
+	void (*link_refresh_all) (NMPlatform *self);
 	gboolean (*link_set_netns) (NMPlatform *self, int ifindex, int netns_fd);
 	gboolean (*link_set_up) (NMPlatform *self, int ifindex, gboolean *out_no_firmware);
 	gboolean (*link_set_down) (NMPlatform *self, int ifindex);
@@ -1599,6 +1600,7 @@ gboolean nm_platform_link_supports_slaves (NMPlatform *self, int ifindex);
 const char *nm_platform_link_get_type_name (NMPlatform *self, int ifindex);
 
 gboolean nm_platform_link_refresh (NMPlatform *self, int ifindex);
+void nm_platform_link_refresh_all (NMPlatform *self);
 void nm_platform_process_events (NMPlatform *self);
 
 const NMPlatformLink *nm_platform_process_events_ensure_link (NMPlatform *self,
@@ -519,6 +519,44 @@ nm_settings_connection_clear_secrets (NMSettingsConnection *self,
 		nm_assert_not_reached ();
 }
 
+/**
+ * nm_settings_connection_reset_secrets:
+ * @self: the #NMSettingsConnection
+ *
+ * Drops all secrets that were not read from the storage, like secrets
+ * provided by secret-agents, and restores the system secrets as they
+ * were last read. That is what re-reading the profile from an unchanged
+ * file would do.
+ */
+void
+nm_settings_connection_reset_secrets (NMSettingsConnection *self)
+{
+	NMSettingsConnectionPrivate *priv;
+	gs_unref_object NMConnection *connection_cloned = NULL;
+
+	if (!nm_settings_connection_still_valid (self))
+		return;
+
+	priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
+
+	connection_cloned = nm_simple_connection_new_clone (priv->connection);
+
+	nm_connection_clear_secrets (connection_cloned);
+	if (priv->system_secrets)
+		nm_connection_update_secrets (connection_cloned, NULL, priv->system_secrets, NULL);
+
+	if (!nm_settings_connection_update (self,
+	                                    connection_cloned,
+	                                    NM_SETTINGS_CONNECTION_PERSIST_MODE_NO_PERSIST,
+	                                    NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+	                                    NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+	                                      NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_SYSTEM_SECRETS
+	                                    | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_AGENT_SECRETS,
+	                                    "reset-secrets",
+	                                    NULL))
+		nm_assert_not_reached ();
+}
+
 static gboolean
 _secrets_update (NMConnection *connection,
                  const char *setting_name,
@@ -2148,6 +2186,8 @@ nm_settings_connection_update_timestamp (NMSettingsConnection *self,
 	if (!priv->kf_db_timestamps)
 		return;
 
+	_nm_settings_connection_timestamp_changed (priv->settings, self);
+
 	connection_uuid = nm_settings_connection_get_uuid (self);
 	if (connection_uuid) {
 		nm_key_file_db_set_value (priv->kf_db_timestamps,
@@ -271,6 +271,8 @@ void nm_settings_connection_clear_secrets (NMSettingsConnection *self,
                                            gboolean clear_cached_system_secrets,
                                            gboolean persist);
 
+void nm_settings_connection_reset_secrets (NMSettingsConnection *self);
+
 gboolean nm_settings_connection_check_visibility (NMSettingsConnection *self,
                                                   NMSessionMonitor *session_monitor);
 
@@ -18,6 +18,7 @@
 enum {
 	UNMANAGED_SPECS_CHANGED,
 	UNRECOGNIZED_SPECS_CHANGED,
+	CONNECTION_FILES_CHANGED,
 
 	LAST_SIGNAL
 };
@@ -266,6 +267,16 @@ _nm_settings_plugin_emit_signal_unrecognized_specs_changed (NMSettingsPlugin *se
 	g_signal_emit (self, signals[UNRECOGNIZED_SPECS_CHANGED], 0);
 }
 
+void
+_nm_settings_plugin_emit_signal_connection_files_changed (NMSettingsPlugin *self,
+                                                         const char *const*filenames)
+{
+	nm_assert (NM_IS_SETTINGS_PLUGIN (self));
+	nm_assert (filenames && filenames[0]);
+
+	g_signal_emit (self, signals[CONNECTION_FILES_CHANGED], 0, filenames);
+}
+
 /*****************************************************************************/
 
 static void
@@ -293,4 +304,14 @@ nm_settings_plugin_class_init (NMSettingsPluginClass *klass)
 	                  0, NULL, NULL,
 	                  g_cclosure_marshal_VOID__VOID,
 	                  G_TYPE_NONE, 0);
+
+	/* the plugin noticed changes to the files in @filenames (a strv). These
+	 * should be (re)loaded like for LoadConnections(). */
+	signals[CONNECTION_FILES_CHANGED] =
+	    g_signal_new (NM_SETTINGS_PLUGIN_CONNECTION_FILES_CHANGED,
+	                  G_OBJECT_CLASS_TYPE (object_class),
+	                  G_SIGNAL_RUN_FIRST,
+	                  0, NULL, NULL,
+	                  g_cclosure_marshal_VOID__POINTER,
+	                  G_TYPE_NONE, 1, G_TYPE_POINTER);
 }
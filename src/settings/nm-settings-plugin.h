@@ -33,6 +33,7 @@ typedef struct {
 
 #define NM_SETTINGS_PLUGIN_UNMANAGED_SPECS_CHANGED    "unmanaged-specs-changed"
 #define NM_SETTINGS_PLUGIN_UNRECOGNIZED_SPECS_CHANGED "unrecognized-specs-changed"
+#define NM_SETTINGS_PLUGIN_CONNECTION_FILES_CHANGED   "connection-files-changed"
 
 struct _NMSettingsPlugin {
 	GObject parent;
@@ -180,6 +181,9 @@ void _nm_settings_plugin_emit_signal_unmanaged_specs_changed (NMSettingsPlugin *
 
 void _nm_settings_plugin_emit_signal_unrecognized_specs_changed (NMSettingsPlugin *self);
 
+void _nm_settings_plugin_emit_signal_connection_files_changed (NMSettingsPlugin *self,
+                                                              const char *const*filenames);
+
 /*****************************************************************************/
 
 int nm_settings_plugin_cmp_by_priority (const NMSettingsPlugin *a,
@@ -11,6 +11,9 @@
 #include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <fcntl.h>
+
+#include "nm-glib-aux/nm-io-utils.h"
 
 #include "nm-settings-plugin.h"
 
@@ -52,6 +55,198 @@ nm_sett_util_stat_mtime (const char *filename,
 
 /*****************************************************************************/
 
+void
+nm_sett_util_file_id_init (NMSettUtilFileId *file_id,
+                           const struct stat *st)
+{
+	nm_assert (file_id);
+	nm_assert (st);
+
+	*file_id = (NMSettUtilFileId) {
+		.st_mtim = st->st_mtim,
+		.st_ctim = st->st_ctim,
+		.st_dev  = st->st_dev,
+		.st_ino  = st->st_ino,
+		.st_size = st->st_size,
+	};
+}
+
+gboolean
+nm_sett_util_file_id_stat (const char *filename,
+                           NMSettUtilFileId *out_file_id)
+{
+	struct stat st;
+
+	nm_assert (filename);
+	nm_assert (out_file_id);
+
+	if (stat (filename, &st) != 0) {
+		*out_file_id = (NMSettUtilFileId) { };
+		return FALSE;
+	}
+
+	nm_sett_util_file_id_init (out_file_id, &st);
+	return TRUE;
+}
+
+/* Like nm_sett_util_file_id_stat(), but for a symlink, this gets the
+ * file-id of the link itself. */
+gboolean
+nm_sett_util_file_id_lstat (const char *filename,
+                            NMSettUtilFileId *out_file_id)
+{
+	struct stat st;
+
+	nm_assert (filename);
+	nm_assert (out_file_id);
+
+	if (lstat (filename, &st) != 0) {
+		*out_file_id = (NMSettUtilFileId) { };
+		return FALSE;
+	}
+
+	nm_sett_util_file_id_init (out_file_id, &st);
+	return TRUE;
+}
+
+void
+nm_sett_util_file_id_hash_update (const NMSettUtilFileId *file_id,
+                                  NMHashState *h)
+{
+	nm_hash_update_vals (h,
+	                     file_id->st_dev,
+	                     file_id->st_ino,
+	                     file_id->st_size,
+	                     file_id->st_mtim.tv_sec,
+	                     file_id->st_mtim.tv_nsec,
+	                     file_id->st_ctim.tv_sec,
+	                     file_id->st_ctim.tv_nsec);
+}
+
+/*****************************************************************************/
+
+#define SYNC_BATCHED_DELAY_MSEC 1000
+
+static struct {
+	/* the directories that have unsynced writes. */
+	GHashTable *dirs;
+	guint timeout_id;
+	bool batched:1;
+} _sync;
+
+static gboolean
+_sync_timeout_cb (gpointer user_data)
+{
+	_sync.timeout_id = 0;
+	nm_sett_util_sync ();
+	return G_SOURCE_REMOVE;
+}
+
+void
+nm_sett_util_set_sync_batched (gboolean batched)
+{
+	if (_sync.batched == (!!batched))
+		return;
+
+	_sync.batched = batched;
+	if (!batched)
+		nm_sett_util_sync ();
+}
+
+gboolean
+nm_sett_util_file_set_contents (const char *filename,
+                                const char *contents,
+                                gssize length,
+                                mode_t mode,
+                                int *out_errsv,
+                                GError **error)
+{
+	if (!_sync.batched) {
+		return nm_utils_file_set_contents (filename,
+		                                   contents,
+		                                   length,
+		                                   mode,
+		                                   out_errsv,
+		                                   error);
+	}
+
+	if (!nm_utils_file_set_contents_full (filename,
+	                                      contents,
+	                                      length,
+	                                      mode,
+	                                      NM_UTILS_FILE_SET_CONTENTS_FLAG_NO_FSYNC,
+	                                      out_errsv,
+	                                      error))
+		return FALSE;
+
+	if (!_sync.dirs)
+		_sync.dirs = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_add (_sync.dirs, g_path_get_dirname (filename));
+
+	if (_sync.timeout_id == 0)
+		_sync.timeout_id = g_timeout_add (SYNC_BATCHED_DELAY_MSEC, _sync_timeout_cb, NULL);
+	return TRUE;
+}
+
+/**
+ * nm_sett_util_sync:
+ *
+ * Syncs the file systems of all directories with pending writes. This
+ * is a barrier for writes done with batched syncing. It does nothing,
+ * if there are no pending writes.
+ */
+void
+nm_sett_util_sync (void)
+{
+	gs_unref_hashtable GHashTable *dirs = NULL;
+	gs_unref_array GArray *devs = NULL;
+	GHashTableIter iter;
+	const char *dirname;
+	guint i;
+
+	nm_clear_g_source (&_sync.timeout_id);
+
+	dirs = g_steal_pointer (&_sync.dirs);
+	if (!dirs)
+		return;
+
+	devs = g_array_new (FALSE, FALSE, sizeof (dev_t));
+
+	g_hash_table_iter_init (&iter, dirs);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &dirname, NULL)) {
+		nm_auto_close int fd = -1;
+		struct stat st;
+		int errsv;
+
+		fd = open (dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (   fd < 0
+		    || fstat (fd, &st) != 0) {
+			errsv = errno;
+			nm_log_warn (LOGD_SETTINGS, "settings: failure to sync directory \"%s\": %s",
+			             dirname, nm_strerror_native (errsv));
+			continue;
+		}
+
+		/* syncfs() writes out all files of the file system, and also the
+		 * renames in the directory. Once per file system is enough. */
+		for (i = 0; i < devs->len; i++) {
+			if (g_array_index (devs, dev_t, i) == st.st_dev)
+				break;
+		}
+		if (i < devs->len)
+			continue;
+		g_array_append_val (devs, st.st_dev);
+
+		if (syncfs (fd) != 0) {
+			errsv = errno;
+			nm_log_warn (LOGD_SETTINGS, "settings: failure to sync directory \"%s\": %s",
+			             dirname, nm_strerror_native (errsv));
+		}
+	}
+}
+
+/*****************************************************************************/
+
 gboolean
 nm_sett_util_allow_filename_cb (const char *filename,
                                 gpointer user_data)
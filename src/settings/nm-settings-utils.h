@@ -10,7 +10,7 @@
 
 /*****************************************************************************/
 
-struct timespec;
+#include <time.h>
 
 const struct timespec *nm_sett_util_stat_mtime (const char *filename,
                                                 gboolean do_lstat,
@@ -18,6 +18,69 @@ const struct timespec *nm_sett_util_stat_mtime (const char *filename,
 
 /*****************************************************************************/
 
+/* Identifies the on-disk state of a file. If the file-id of a file
+ * is unchanged, we assume that the file's content is unchanged too.
+ * Note that st_ctim cannot be set by user-space, so even a file
+ * that was rewritten with preserved mtime and size gets a new file-id. */
+typedef struct {
+	struct timespec st_mtim;
+	struct timespec st_ctim;
+	guint64 st_dev;
+	guint64 st_ino;
+	gint64 st_size;
+} NMSettUtilFileId;
+
+struct stat;
+
+void nm_sett_util_file_id_init (NMSettUtilFileId *file_id,
+                                const struct stat *st);
+
+gboolean nm_sett_util_file_id_stat (const char *filename,
+                                    NMSettUtilFileId *out_file_id);
+
+gboolean nm_sett_util_file_id_lstat (const char *filename,
+                                     NMSettUtilFileId *out_file_id);
+
+static inline gboolean
+nm_sett_util_file_id_is_set (const NMSettUtilFileId *file_id)
+{
+	return file_id->st_ino != 0;
+}
+
+static inline gboolean
+nm_sett_util_file_id_equal (const NMSettUtilFileId *a,
+                            const NMSettUtilFileId *b)
+{
+	return    a->st_ino == b->st_ino
+	       && a->st_dev == b->st_dev
+	       && a->st_size == b->st_size
+	       && a->st_mtim.tv_sec == b->st_mtim.tv_sec
+	       && a->st_mtim.tv_nsec == b->st_mtim.tv_nsec
+	       && a->st_ctim.tv_sec == b->st_ctim.tv_sec
+	       && a->st_ctim.tv_nsec == b->st_ctim.tv_nsec;
+}
+
+void nm_sett_util_file_id_hash_update (const NMSettUtilFileId *file_id,
+                                       NMHashState *h);
+
+/*****************************************************************************/
+
+/* With batched syncing, profiles are written without fsync(). Instead,
+ * the file systems of the written directories get synced together a
+ * short while later, or when calling nm_sett_util_sync(). */
+void nm_sett_util_set_sync_batched (gboolean batched);
+
+gboolean nm_sett_util_file_set_contents (const char *filename,
+                                         const char *contents,
+                                         gssize length,
+                                         mode_t mode,
+                                         int *out_errsv,
+                                         GError **error);
+
+void nm_sett_util_sync (void);
+
+/*****************************************************************************/
+
 typedef struct {
 	const char *uuid;
 
@@ -22,6 +22,7 @@
 
 #include "nm-libnm-core-intern/nm-common-macros.h"
 #include "nm-glib-aux/nm-keyfile-aux.h"
+#include "nm-glib-aux/nm-record-file-db.h"
 #include "nm-keyfile/nm-keyfile-internal.h"
 #include "nm-dbus-interface.h"
 #include "nm-connection.h"
@@ -52,6 +53,7 @@
 #include "devices/nm-device-ethernet.h"
 #include "nm-settings-connection.h"
 #include "nm-settings-plugin.h"
+#include "nm-settings-utils.h"
 #include "nm-dbus-manager.h"
 #include "nm-auth-utils.h"
 #include "nm-libnm-core-intern/nm-auth-subject.h"
@@ -358,6 +360,13 @@ typedef struct {
 	NMKeyFileDB *kf_db_timestamps;
 	NMKeyFileDB *kf_db_seen_bssids;
 
+	/* the timestamps are persisted here. The keyfile in kf_db_timestamps
+	 * is only written on shutdown. */
+	NMRecordFileDB *rec_db_timestamps;
+
+	/* UUIDs whose timestamp changed since the last update of rec_db_timestamps. */
+	GHashTable *rec_db_timestamps_dirty;
+
 	GHashTable *sce_idx;
 
 	CList sce_dirty_lst_head;
@@ -1206,6 +1215,10 @@ _connection_changed_delete (NMSettings *self,
 
 	nm_key_file_db_remove_key (priv->kf_db_timestamps, uuid);
 	nm_key_file_db_remove_key (priv->kf_db_seen_bssids, uuid);
+	if (priv->rec_db_timestamps) {
+		nm_record_file_db_remove (priv->rec_db_timestamps, uuid);
+		g_hash_table_remove (priv->rec_db_timestamps_dirty, uuid);
+	}
 
 	if (   !priv->started
 	    || priv->startup_complete_idx)
@@ -1402,16 +1415,45 @@ _plugin_connections_reload_cb (NMSettingsPlugin *plugin,
 	_connection_changed_track (user_data, storage, connection, FALSE);
 }
 
+typedef struct {
+	NMSettings *self;
+	GHashTable *reported_uuids;
+} PluginConnectionsReloadData;
+
+static void
+_plugin_connections_reload_all_cb (NMSettingsPlugin *plugin,
+                                   NMSettingsStorage *storage,
+                                   NMConnection *connection,
+                                   gpointer user_data)
+{
+	PluginConnectionsReloadData *reload_data = user_data;
+
+	g_hash_table_add (reload_data->reported_uuids,
+	                  g_strdup (nm_settings_storage_get_uuid (storage)));
+	_connection_changed_track (reload_data->self, storage, connection, FALSE);
+}
+
 static void
 _plugin_connections_reload (NMSettings *self)
 {
 	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_unref_hashtable GHashTable *reported_uuids = NULL;
+	gs_unref_ptrarray GPtrArray *sett_conns = NULL;
+	PluginConnectionsReloadData reload_data;
+	NMSettingsConnection *sett_conn;
 	GSList *iter;
+	guint i;
+
+	reported_uuids = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	reload_data = (PluginConnectionsReloadData) {
+		.self           = self,
+		.reported_uuids = reported_uuids,
+	};
 
 	for (iter = priv->plugins; iter; iter = iter->next) {
 		nm_settings_plugin_reload_connections (iter->data,
-		                                       _plugin_connections_reload_cb,
-		                                       self);
+		                                       _plugin_connections_reload_all_cb,
+		                                       &reload_data);
 	}
 
 	_connection_changed_process_all_dirty (self,
@@ -1422,6 +1464,17 @@ _plugin_connections_reload (NMSettings *self)
 	                                         NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_SYSTEM_SECRETS
 	                                       | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_AGENT_SECRETS);
 
+	/* plugins don't report profiles whose files are unchanged. Still, a reload
+	 * drops the secrets that are not backed by the files, as if the profiles
+	 * were re-read. */
+	sett_conns = g_ptr_array_new_with_free_func (g_object_unref);
+	c_list_for_each_entry (sett_conn, &priv->connections_lst_head, _connections_lst) {
+		if (!g_hash_table_contains (reported_uuids, nm_settings_connection_get_uuid (sett_conn)))
+			g_ptr_array_add (sett_conns, g_object_ref (sett_conn));
+	}
+	for (i = 0; i < sett_conns->len; i++)
+		nm_settings_connection_reset_secrets (sett_conns->pdata[i]);
+
 	for (iter = priv->plugins; iter; iter = iter->next)
 		nm_settings_plugin_load_connections_done (iter->data);
 }
@@ -2636,6 +2689,61 @@ impl_settings_add_connection_unsaved (NMDBusObject *obj,
 	settings_add_connection_helper (self, invocation, FALSE, settings, NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY);
 }
 
+static gboolean
+_add_connection2_parse_args (guint32 flags_u,
+                             GVariant *args,
+                             NMSettingsAddConnection2Flags *out_flags,
+                             GError **error)
+{
+	NMSettingsAddConnection2Flags flags;
+	const char *args_name;
+	GVariantIter iter;
+
+	if (NM_FLAGS_ANY (flags_u, ~((guint32) (  NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+	                                        | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
+	                                        | NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)))) {
+		g_set_error_literal (error,
+		                     NM_SETTINGS_ERROR,
+		                     NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+		                     "Unknown flags");
+		return FALSE;
+	}
+
+	flags = flags_u;
+
+	if (!NM_FLAGS_ANY (flags,   NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+	                          | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
+		g_set_error_literal (error,
+		                     NM_SETTINGS_ERROR,
+		                     NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+		                     "Requires either to-disk (0x1) or in-memory (0x2) flags");
+		return FALSE;
+	}
+
+	if (NM_FLAGS_ALL (flags,   NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+	                         | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
+		g_set_error_literal (error,
+		                     NM_SETTINGS_ERROR,
+		                     NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+		                     "Cannot set to-disk (0x1) and in-memory (0x2) flags together");
+		return FALSE;
+	}
+
+	nm_assert (g_variant_is_of_type (args, G_VARIANT_TYPE ("a{sv}")));
+
+	g_variant_iter_init (&iter, args);
+	while (g_variant_iter_next (&iter, "{&sv}", &args_name, NULL)) {
+		g_set_error (error,
+		             NM_SETTINGS_ERROR,
+		             NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+		             "Unsupported argument '%s'", args_name);
+		return FALSE;
+	}
+
+	*out_flags = flags;
+	return TRUE;
+}
+
 static void
 impl_settings_add_connection2 (NMDBusObject *obj,
                                const NMDBusInterfaceInfoExtended *interface_info,
@@ -2649,58 +2757,351 @@ impl_settings_add_connection2 (NMDBusObject *obj,
 	gs_unref_variant GVariant *settings = NULL;
 	gs_unref_variant GVariant *args = NULL;
 	NMSettingsAddConnection2Flags flags;
-	const char *args_name;
-	GVariantIter iter;
+	GError *error = NULL;
 	guint32 flags_u;
 
 	g_variant_get (parameters, "(@a{sa{sv}}u@a{sv})", &settings, &flags_u, &args);
 
-	if (NM_FLAGS_ANY (flags_u, ~((guint32) (  NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
-	                                        | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
-	                                        | NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)))) {
-		g_dbus_method_invocation_take_error (invocation,
-		                                     g_error_new_literal (NM_SETTINGS_ERROR,
-		                                                          NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-		                                                          "Unknown flags"));
+	if (!_add_connection2_parse_args (flags_u, args, &flags, &error)) {
+		g_dbus_method_invocation_take_error (invocation, error);
 		return;
 	}
 
-	flags = flags_u;
+	settings_add_connection_helper (self, invocation, TRUE, settings, flags);
+}
 
-	if (!NM_FLAGS_ANY (flags,   NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
-	                          | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
-		g_dbus_method_invocation_take_error (invocation,
-		                                     g_error_new_literal (NM_SETTINGS_ERROR,
-		                                                          NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-		                                                          "Requires either to-disk (0x1) or in-memory (0x2) flags"));
+/*****************************************************************************/
+
+typedef struct {
+	/* %NULL if the item already failed. */
+	NMConnection *connection;
+	GError *error;
+	char *path;
+} AddConnectionsItem;
+
+typedef struct {
+	NMSettingsConnectionPersistMode persist_mode;
+	NMSettingsConnectionAddReason add_reason;
+	guint n_items;
+	AddConnectionsItem items[];
+} AddConnectionsData;
+
+static void
+_add_connections_data_free (gpointer user_data)
+{
+	AddConnectionsData *data = user_data;
+	guint i;
+
+	for (i = 0; i < data->n_items; i++) {
+		AddConnectionsItem *item = &data->items[i];
+
+		nm_g_object_unref (item->connection);
+		nm_clear_error (&item->error);
+		g_free (item->path);
+	}
+	g_free (data);
+}
+
+static void
+_add_connections_return (GDBusMethodInvocation *context,
+                         const AddConnectionsData *data)
+{
+	GVariantBuilder builder;
+	guint i;
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sv}"));
+	for (i = 0; i < data->n_items; i++) {
+		const AddConnectionsItem *item = &data->items[i];
+
+		g_variant_builder_open (&builder, G_VARIANT_TYPE_VARDICT);
+		if (item->path) {
+			g_variant_builder_add (&builder, "{sv}", "path",
+			                       g_variant_new_object_path (item->path));
+		} else {
+			nm_assert (item->error);
+			g_variant_builder_add (&builder, "{sv}", "error",
+			                       g_variant_new_string (item->error->message));
+		}
+		g_variant_builder_close (&builder);
+	}
+
+	g_dbus_method_invocation_return_value (context,
+	                                       g_variant_new ("(aa{sv})", &builder));
+}
+
+static void
+pk_add_connections_cb (NMAuthChain *chain,
+                       GDBusMethodInvocation *context,
+                       gpointer user_data)
+{
+	NMSettings *self = NM_SETTINGS (user_data);
+	gs_unref_ptrarray GPtrArray *added_lst = NULL;
+	AddConnectionsData *data;
+	NMAuthCallResult result;
+	NMAuthSubject *subject;
+	const char *perm;
+	guint i;
+
+	nm_assert (G_IS_DBUS_METHOD_INVOCATION (context));
+
+	c_list_unlink (nm_auth_chain_parent_lst_list (chain));
+
+	perm = nm_auth_chain_get_data (chain, "perm");
+	data = nm_auth_chain_get_data (chain, "data");
+	subject = nm_auth_chain_get_data (chain, "subject");
+
+	result = nm_auth_chain_get_result (chain, perm);
+
+	added_lst = g_ptr_array_new_with_free_func (g_object_unref);
+
+	/* the "Connections" property changes once for every profile. Only
+	 * notify about it once at the end. */
+	g_object_freeze_notify (G_OBJECT (self));
+
+	for (i = 0; i < data->n_items; i++) {
+		AddConnectionsItem *item = &data->items[i];
+		NMSettingsConnection *added = NULL;
+
+		if (!item->connection) {
+			/* the item already failed before authorization. It is
+			 * audit-logged along with the others. */
+			nm_assert (item->error);
+		} else if (result != NM_AUTH_CALL_RESULT_YES) {
+			item->error = g_error_new_literal (NM_SETTINGS_ERROR,
+			                                   NM_SETTINGS_ERROR_PERMISSION_DENIED,
+			                                   NM_UTILS_ERROR_MSG_INSUFF_PRIV);
+		} else if (nm_settings_add_connection (self,
+		                                       item->connection,
+		                                       data->persist_mode,
+		                                       data->add_reason,
+		                                       NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+		                                       &added,
+		                                       &item->error)) {
+			item->path = g_strdup (nm_dbus_object_get_path (NM_DBUS_OBJECT (added)));
+			g_ptr_array_add (added_lst, g_object_ref (added));
+		}
+
+		if (item->error) {
+			nm_audit_log_connection_op (NM_AUDIT_OP_CONN_ADD, NULL, FALSE, NULL,
+			                            subject, item->error->message);
+		} else {
+			nm_audit_log_connection_op (NM_AUDIT_OP_CONN_ADD, added, TRUE, NULL,
+			                            subject, NULL);
+		}
+	}
+
+	g_object_thaw_notify (G_OBJECT (self));
+
+	_add_connections_return (context, data);
+
+	for (i = 0; i < added_lst->len; i++) {
+		NMSettingsConnection *added = added_lst->pdata[i];
+
+		if (nm_settings_has_connection (self, added))
+			send_agent_owned_secrets (self, added, subject);
+	}
+}
+
+static void
+impl_settings_add_connections (NMDBusObject *obj,
+                               const NMDBusInterfaceInfoExtended *interface_info,
+                               const NMDBusMethodInfoExtended *method_info,
+                               GDBusConnection *connection,
+                               const char *sender,
+                               GDBusMethodInvocation *invocation,
+                               GVariant *parameters)
+{
+	NMSettings *self = NM_SETTINGS (obj);
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_unref_variant GVariant *settings_arr = NULL;
+	gs_unref_variant GVariant *args = NULL;
+	gs_unref_object NMAuthSubject *subject = NULL;
+	AddConnectionsData *data;
+	NMSettingsAddConnection2Flags flags;
+	const char *perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_OWN;
+	GError *error = NULL;
+	NMAuthChain *chain;
+	guint n_pending = 0;
+	guint32 flags_u;
+	guint i;
+
+	g_variant_get (parameters, "(@aa{sa{sv}}u@a{sv})", &settings_arr, &flags_u, &args);
+
+	if (!_add_connection2_parse_args (flags_u, args, &flags, &error)) {
+		g_dbus_method_invocation_take_error (invocation, error);
 		return;
 	}
 
-	if (NM_FLAGS_ALL (flags,   NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
-	                         | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
-		g_dbus_method_invocation_take_error (invocation,
-		                                     g_error_new_literal (NM_SETTINGS_ERROR,
-		                                                          NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-		                                                          "Cannot set to-disk (0x1) and in-memory (0x2) flags together"));
+	subject = nm_dbus_manager_new_auth_subject_from_context (invocation);
+	if (!subject) {
+		g_dbus_method_invocation_return_error_literal (invocation,
+		                                               NM_SETTINGS_ERROR,
+		                                               NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                               NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
 		return;
 	}
 
-	nm_assert (g_variant_is_of_type (args, G_VARIANT_TYPE ("a{sv}")));
+	data = g_malloc0 (sizeof (AddConnectionsData) + g_variant_n_children (settings_arr) * sizeof (AddConnectionsItem));
+	data->n_items = g_variant_n_children (settings_arr);
+	data->persist_mode =   NM_FLAGS_HAS (flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK)
+	                     ? NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK
+	                     : NM_SETTINGS_CONNECTION_PERSIST_MODE_IN_MEMORY_ONLY;
+	data->add_reason =   NM_FLAGS_HAS (flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)
+	                   ? NM_SETTINGS_CONNECTION_ADD_REASON_BLOCK_AUTOCONNECT
+	                   : NM_SETTINGS_CONNECTION_ADD_REASON_NONE;
+
+	/* Validate all profiles up front. Invalid ones fail individually,
+	 * the others are authorized together with a single request. */
+	for (i = 0; i < data->n_items; i++) {
+		AddConnectionsItem *item = &data->items[i];
+		gs_unref_variant GVariant *settings = NULL;
+		gs_unref_object NMConnection *con = NULL;
+		gs_free_error GError *local = NULL;
+		NMSettingConnection *s_con;
 
-	g_variant_iter_init (&iter, args);
-	while (g_variant_iter_next (&iter, "{&sv}", &args_name, NULL)) {
-		g_dbus_method_invocation_take_error (invocation,
-		                                     g_error_new (NM_SETTINGS_ERROR,
-		                                                  NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-		                                                  "Unsupported argument '%s'", args_name));
+		settings = g_variant_get_child_value (settings_arr, i);
+
+		con = _nm_simple_connection_new_from_dbus (settings,
+		                                             NM_SETTING_PARSE_FLAGS_STRICT
+		                                           | NM_SETTING_PARSE_FLAGS_NORMALIZE,
+		                                           &item->error);
+		if (   !con
+		    || !nm_connection_verify_secrets (con, &item->error))
+			continue;
+
+		if (_nm_connection_verify (con, &local) != NM_SETTING_VERIFY_SUCCESS) {
+			item->error = g_error_new (NM_SETTINGS_ERROR,
+			                           NM_SETTINGS_ERROR_INVALID_CONNECTION,
+			                           "The connection was invalid: %s",
+			                           local->message);
+			continue;
+		}
+
+		if (!nm_auth_is_subject_in_acl_set_error (con,
+		                                          subject,
+		                                          NM_SETTINGS_ERROR,
+		                                          NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                          &item->error))
+			continue;
+
+		/* like for AddConnection, 'modify.own' suffices if the caller is the
+		 * only user of the profile. One profile that affects more than the
+		 * caller requires 'modify.system' for the entire request. */
+		s_con = nm_connection_get_setting_connection (con);
+		if (nm_setting_connection_get_num_permissions (s_con) != 1)
+			perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM;
+
+		item->connection = g_steal_pointer (&con);
+		n_pending++;
+	}
+
+	if (n_pending == 0) {
+		for (i = 0; i < data->n_items; i++) {
+			nm_audit_log_connection_op (NM_AUDIT_OP_CONN_ADD, NULL, FALSE, NULL,
+			                            subject, data->items[i].error->message);
+		}
+		_add_connections_return (invocation, data);
+		_add_connections_data_free (data);
 		return;
 	}
 
-	settings_add_connection_helper (self, invocation, TRUE, settings, flags);
+	chain = nm_auth_chain_new_subject (subject, invocation, pk_add_connections_cb, self);
+	if (!chain) {
+		for (i = 0; i < data->n_items; i++) {
+			nm_audit_log_connection_op (NM_AUDIT_OP_CONN_ADD, NULL, FALSE, NULL,
+			                            subject,
+			                              data->items[i].error
+			                            ? data->items[i].error->message
+			                            : NM_UTILS_ERROR_MSG_REQ_AUTH_FAILED);
+		}
+		_add_connections_data_free (data);
+		g_dbus_method_invocation_return_error_literal (invocation,
+		                                               NM_SETTINGS_ERROR,
+		                                               NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                               NM_UTILS_ERROR_MSG_REQ_AUTH_FAILED);
+		return;
+	}
+
+	c_list_link_tail (&priv->auth_lst_head, nm_auth_chain_parent_lst_list (chain));
+
+	nm_auth_chain_set_data (chain, "perm", (gpointer) perm, NULL);
+	nm_auth_chain_set_data (chain, "data", data, _add_connections_data_free);
+	nm_auth_chain_set_data (chain, "subject", g_object_ref (subject), g_object_unref);
+	nm_auth_chain_add_call_unsafe (chain, perm, TRUE);
 }
 
 /*****************************************************************************/
 
+static GPtrArray *
+_plugin_connections_load (NMSettings *self,
+                          const char *const*filenames)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	NMSettingsPluginConnectionLoadEntry *entries;
+	GPtrArray *failures = NULL;
+	gsize n_entries;
+	gsize i;
+	GSList *iter;
+
+	nm_assert (filenames && filenames[0]);
+
+	entries = nm_settings_plugin_create_connection_load_entries (filenames, &n_entries);
+
+	for (iter = priv->plugins; iter; iter = iter->next) {
+		NMSettingsPlugin *plugin = iter->data;
+
+		nm_settings_plugin_load_connections (plugin,
+		                                     entries,
+		                                     n_entries,
+		                                     _plugin_connections_reload_cb,
+		                                     self);
+	}
+
+	for (i = 0; i < n_entries; i++) {
+		NMSettingsPluginConnectionLoadEntry *entry = &entries[i];
+
+		if (!entry->handled) {
+			_LOGW ("load: no settings plugin could load \"%s\"", entry->filename);
+			nm_assert (!entry->error);
+		} else if (entry->error) {
+			_LOGW ("load: failure to load \"%s\": %s", entry->filename, entry->error->message);
+			g_clear_error (&entry->error);
+		} else
+			continue;
+
+		if (!failures)
+			failures = g_ptr_array_new ();
+		g_ptr_array_add (failures, (char *) entry->filename);
+	}
+
+	nm_clear_g_free (&entries);
+
+	_connection_changed_process_all_dirty (self,
+	                                       TRUE,
+	                                       NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+	                                       NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+	                                       TRUE,
+	                                         NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_SYSTEM_SECRETS
+	                                       | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_AGENT_SECRETS);
+
+	for (iter = priv->plugins; iter; iter = iter->next)
+		nm_settings_plugin_load_connections_done (iter->data);
+
+	return failures;
+}
+
+static void
+_plugin_connection_files_changed (NMSettingsPlugin *plugin,
+                                  const char *const*filenames,
+                                  gpointer user_data)
+{
+	NMSettings *self = NM_SETTINGS (user_data);
+	gs_unref_ptrarray GPtrArray *failures = NULL;
+
+	_LOGD ("load: %zu files changed on disk", NM_PTRARRAY_LEN (filenames));
+	failures = _plugin_connections_load (self, filenames);
+}
+
 static void
 impl_settings_load_connections (NMDBusObject *obj,
                                 const NMDBusInterfaceInfoExtended *interface_info,
@@ -2711,7 +3112,6 @@ impl_settings_load_connections (NMDBusObject *obj,
                                 GVariant *parameters)
 {
 	NMSettings *self = NM_SETTINGS (obj);
-	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
 	gs_unref_ptrarray GPtrArray *failures = NULL;
 	gs_free const char **filenames = NULL;
 	gs_free char *op_result_str = NULL;
@@ -2730,54 +3130,8 @@ impl_settings_load_connections (NMDBusObject *obj,
 		return;
 
 	if (   filenames
-	    && filenames[0]) {
-		NMSettingsPluginConnectionLoadEntry *entries;
-		gsize n_entries;
-		gsize i;
-		GSList *iter;
-
-		entries = nm_settings_plugin_create_connection_load_entries (filenames, &n_entries);
-
-		for (iter = priv->plugins; iter; iter = iter->next) {
-			NMSettingsPlugin *plugin = iter->data;
-
-			nm_settings_plugin_load_connections (plugin,
-			                                     entries,
-			                                     n_entries,
-			                                     _plugin_connections_reload_cb,
-			                                     self);
-		}
-
-		for (i = 0; i < n_entries; i++) {
-			NMSettingsPluginConnectionLoadEntry *entry = &entries[i];
-
-			if (!entry->handled) {
-				_LOGW ("load: no settings plugin could load \"%s\"", entry->filename);
-				nm_assert (!entry->error);
-			} else if (entry->error) {
-				_LOGW ("load: failure to load \"%s\": %s", entry->filename, entry->error->message);
-				g_clear_error (&entry->error);
-			} else
-				continue;
-
-			if (!failures)
-				failures = g_ptr_array_new ();
-			g_ptr_array_add (failures, (char *) entry->filename);
-		}
-
-		nm_clear_g_free (&entries);
-
-		_connection_changed_process_all_dirty (self,
-		                                       TRUE,
-		                                       NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
-		                                       NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
-		                                       TRUE,
-		                                         NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_SYSTEM_SECRETS
-		                                       | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_AGENT_SECRETS);
-
-		for (iter = priv->plugins; iter; iter = iter->next)
-			nm_settings_plugin_load_connections_done (iter->data);
-	}
+	    && filenames[0])
+		failures = _plugin_connections_load (self, filenames);
 
 	if (failures)
 		g_ptr_array_add (failures, NULL);
@@ -3592,6 +3946,91 @@ _kf_db_log_fcn (NMKeyFileDB *kf_db,
 	}
 }
 
+G_GNUC_PRINTF (4, 5)
+static void
+_rec_db_log_fcn (NMRecordFileDB *rec_db,
+                 int syslog_level,
+                 gpointer user_data,
+                 const char *fmt,
+                 ...)
+{
+	NMSettings *self = user_data;
+	NMLogLevel level = nm_log_level_from_syslog (syslog_level);
+
+	if (_NMLOG_ENABLED (level)) {
+		gs_free char *msg = NULL;
+		va_list ap;
+
+		va_start (ap, fmt);
+		msg = g_strdup_vprintf (fmt, ap);
+		va_end (ap);
+
+		_NMLOG (level, "[timestamps-db]: %s", msg);
+	}
+}
+
+static void
+_rec_db_timestamps_import_cb (const char *uuid,
+                              guint64 timestamp,
+                              gpointer user_data)
+{
+	NMSettings *self = user_data;
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_free char *str = NULL;
+	char sbuf[30];
+
+	/* the record file is usually more recent than the keyfile, which
+	 * is only written on shutdown. Take the newer of both. */
+	str = nm_key_file_db_get_value (priv->kf_db_timestamps, uuid);
+	if (   str
+	    && _nm_utils_ascii_str_to_uint64 (str, 10, 0, G_MAXUINT64, 0) >= timestamp)
+		return;
+
+	nm_key_file_db_set_value (priv->kf_db_timestamps,
+	                          uuid,
+	                          nm_sprintf_buf (sbuf, "%" G_GUINT64_FORMAT, timestamp));
+}
+
+static void
+_rec_db_timestamps_update (NMSettings *self)
+{
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	GHashTableIter iter;
+	const char *uuid;
+
+	g_hash_table_iter_init (&iter, priv->rec_db_timestamps_dirty);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &uuid, NULL)) {
+		NMSettingsConnection *sett_conn;
+		guint64 timestamp;
+
+		sett_conn = nm_settings_get_connection_by_uuid (self, uuid);
+		if (   sett_conn
+		    && nm_settings_connection_get_timestamp (sett_conn, &timestamp))
+			nm_record_file_db_set (priv->rec_db_timestamps, uuid, timestamp);
+		g_hash_table_iter_remove (&iter);
+	}
+}
+
+void
+_nm_settings_connection_timestamp_changed (NMSettings *self,
+                                           NMSettingsConnection *sett_conn)
+{
+	NMSettingsPrivate *priv;
+	const char *uuid;
+
+	g_return_if_fail (NM_IS_SETTINGS (self));
+
+	priv = NM_SETTINGS_GET_PRIVATE (self);
+	if (!priv->rec_db_timestamps)
+		return;
+
+	uuid = nm_settings_connection_get_uuid (sett_conn);
+	if (uuid)
+		g_hash_table_add (priv->rec_db_timestamps_dirty, g_strdup (uuid));
+}
+
+/*****************************************************************************/
+
 static gboolean
 _kf_db_got_dirty_flush (NMSettings *self,
                         gboolean is_timestamps)
@@ -3610,7 +4049,13 @@ _kf_db_got_dirty_flush (NMSettings *self,
 		priv->kf_db_flush_idle_id_seen_bssids = 0;
 	}
 
-	if (nm_key_file_db_is_dirty (kf_db))
+	if (   is_timestamps
+	    && priv->rec_db_timestamps) {
+		/* update the records in place instead of rewriting the keyfile
+		 * every time a connection gets activated. */
+		_rec_db_timestamps_update (self);
+		nm_key_file_db_clear_dirty (kf_db);
+	} else if (nm_key_file_db_is_dirty (kf_db))
 		nm_key_file_db_to_file (kf_db, FALSE);
 	else {
 		_LOGT ("[%s-keyfile]: skip saving changes to \"%s\"",
@@ -3676,6 +4121,14 @@ nm_settings_kf_db_write (NMSettings *self)
 		nm_key_file_db_to_file (priv->kf_db_timestamps, TRUE);
 	if (priv->kf_db_seen_bssids)
 		nm_key_file_db_to_file (priv->kf_db_seen_bssids, TRUE);
+	if (priv->rec_db_timestamps) {
+		_rec_db_timestamps_update (self);
+		nm_record_file_db_sync (priv->rec_db_timestamps);
+	}
+
+	/* this is called on shutdown. Also sync profiles that were written
+	 * with batched durability. */
+	nm_sett_util_sync ();
 }
 
 /*****************************************************************************/
@@ -3693,6 +4146,19 @@ nm_settings_start (NMSettings *self, GError **error)
 
 	priv->hostname_manager = g_object_ref (nm_hostname_manager_get ());
 
+	{
+		gs_free char *durability = NULL;
+
+		durability = nm_config_data_get_value (nm_config_get_data_orig (priv->config),
+		                                       NM_CONFIG_KEYFILE_GROUP_MAIN,
+		                                       NM_CONFIG_KEYFILE_KEY_MAIN_SETTINGS_DURABILITY,
+		                                       NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+		if (nm_streq0 (durability, "batched"))
+			nm_sett_util_set_sync_batched (TRUE);
+		else if (!NM_IN_STRSET (durability, NULL, "strict"))
+			_LOGW ("unknown value \"%s\" for main.settings-durability. Use \"strict\"", durability);
+	}
+
 	priv->kf_db_timestamps = nm_key_file_db_new (NMSTATEDIR "/timestamps",
 	                                             "timestamps",
 	                                             _kf_db_log_fcn,
@@ -3706,6 +4172,19 @@ nm_settings_start (NMSettings *self, GError **error)
 	nm_key_file_db_start (priv->kf_db_timestamps);
 	nm_key_file_db_start (priv->kf_db_seen_bssids);
 
+	priv->rec_db_timestamps = nm_record_file_db_new (NMSTATEDIR "/timestamps.db",
+	                                                 _rec_db_log_fcn,
+	                                                 self);
+	if (nm_record_file_db_start (priv->rec_db_timestamps)) {
+		priv->rec_db_timestamps_dirty = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+		nm_record_file_db_foreach (priv->rec_db_timestamps,
+		                           _rec_db_timestamps_import_cb,
+		                           self);
+	} else {
+		/* fallback to writing the keyfile. */
+		nm_clear_pointer (&priv->rec_db_timestamps, nm_record_file_db_destroy);
+	}
+
 	/* Load the plugins; fail if a plugin is not found. */
 	plugins = nm_config_data_get_plugins (nm_config_get_data_orig (priv->config), TRUE);
 
@@ -3719,6 +4198,8 @@ nm_settings_start (NMSettings *self, GError **error)
 		                  G_CALLBACK (_plugin_unmanaged_specs_changed), self);
 		g_signal_connect (plugin, NM_SETTINGS_PLUGIN_UNRECOGNIZED_SPECS_CHANGED,
 		                  G_CALLBACK (_plugin_unrecognized_specs_changed), self);
+		g_signal_connect (plugin, NM_SETTINGS_PLUGIN_CONNECTION_FILES_CHANGED,
+		                  G_CALLBACK (_plugin_connection_files_changed), self);
 	}
 
 	_plugin_unmanaged_specs_changed (NULL, self);
@@ -3887,9 +4368,16 @@ finalize (GObject *object)
 	nm_clear_g_source (&priv->kf_db_flush_idle_id_seen_bssids);
 	nm_key_file_db_to_file (priv->kf_db_timestamps, FALSE);
 	nm_key_file_db_to_file (priv->kf_db_seen_bssids, FALSE);
+	if (priv->rec_db_timestamps) {
+		nm_record_file_db_sync (priv->rec_db_timestamps);
+		nm_clear_pointer (&priv->rec_db_timestamps, nm_record_file_db_destroy);
+	}
+	nm_clear_pointer (&priv->rec_db_timestamps_dirty, g_hash_table_unref);
 	nm_key_file_db_destroy (priv->kf_db_timestamps);
 	nm_key_file_db_destroy (priv->kf_db_seen_bssids);
 
+	nm_sett_util_sync ();
+
 	G_OBJECT_CLASS (nm_settings_parent_class)->finalize (object);
 
 	g_clear_object (&priv->config);
@@ -3975,6 +4463,20 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
 				),
 				.handle = impl_settings_add_connection2,
 			),
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"AddConnections",
+					.in_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("settings", "aa{sa{sv}}"),
+						NM_DEFINE_GDBUS_ARG_INFO ("flags",    "u"),
+						NM_DEFINE_GDBUS_ARG_INFO ("args",     "a{sv}"),
+					),
+					.out_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("results", "aa{sv}"),
+					),
+				),
+				.handle = impl_settings_add_connections,
+			),
 			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
 				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
 					"LoadConnections",
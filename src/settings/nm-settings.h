@@ -126,4 +126,7 @@ const char *nm_settings_get_startup_complete_blocked_reason (NMSettings *self);
 
 void nm_settings_kf_db_write (NMSettings *settings);
 
+void _nm_settings_connection_timestamp_changed (NMSettings *self,
+                                                NMSettingsConnection *sett_conn);
+
 #endif  /* __NM_SETTINGS_H__ */
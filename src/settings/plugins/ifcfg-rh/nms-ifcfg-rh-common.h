@@ -22,6 +22,7 @@
 #define AUGTMP_TAG ".augtmp"
 
 #define IFCFG_DIR SYSCONFDIR "/sysconfig/network-scripts"
+#define IFCFG_NETWORK_FILE SYSCONFDIR "/sysconfig/network"
 
 #define TYPE_ETHERNET   "Ethernet"
 #define TYPE_WIRELESS   "Wireless"
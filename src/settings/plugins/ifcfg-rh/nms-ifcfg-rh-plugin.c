@@ -227,14 +227,40 @@ _load_file (NMSIfcfgRHPlugin *self,
 	                                            &st.st_mtim);
 }
 
+static char *
+_load_dir_files_group (const char *full_path)
+{
+	const char *base;
+
+	base = strrchr (full_path, '/');
+	base = base ? base + 1 : full_path;
+
+	/* rule files are not handled by utils_detect_ifcfg_path(), but their presence
+	 * affects how the profile gets parsed. */
+	if (NM_STR_HAS_PREFIX (base, RULE_TAG))
+		return g_strdup_printf (IFCFG_DIR "/" IFCFG_TAG "%s", &base[NM_STRLEN (RULE_TAG)]);
+	if (NM_STR_HAS_PREFIX (base, RULE6_TAG))
+		return g_strdup_printf (IFCFG_DIR "/" IFCFG_TAG "%s", &base[NM_STRLEN (RULE6_TAG)]);
+
+	return utils_detect_ifcfg_path (full_path, FALSE);
+}
+
 static void
 _load_dir (NMSIfcfgRHPlugin *self,
-           NMSettUtilStorages *storages)
+           NMSettUtilStorages *storages,
+           GHashTable *storages_unchanged)
 {
+	NMSIfcfgRHPluginPrivate *priv = NMS_IFCFG_RH_PLUGIN_GET_PRIVATE (self);
 	gs_unref_hashtable GHashTable *dupl_filenames = NULL;
+	gs_unref_hashtable GHashTable *files_hashes = NULL;
+	gs_unref_ptrarray GPtrArray *full_paths = NULL;
 	gs_free_error GError *local = NULL;
 	const char *f_filename;
+	NMSettUtilFileId file_id;
+	guint64 network_file_hash;
+	NMHashState h;
 	GDir *dir;
+	guint i;
 
 	dir = g_dir_open (IFCFG_DIR, 0, &local);
 	if (!dir) {
@@ -242,15 +268,57 @@ _load_dir (NMSIfcfgRHPlugin *self,
 		return;
 	}
 
-	dupl_filenames = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
+	/* the reader falls back to settings from the global network file (like
+	 * GATEWAY). A change there affects all profiles, so it is part of every
+	 * profile's hash. */
+	nm_hash_init (&h, 1267402311u);
+	if (nm_sett_util_file_id_stat (IFCFG_NETWORK_FILE, &file_id))
+		nm_sett_util_file_id_hash_update (&file_id, &h);
+	network_file_hash = nm_hash_complete_u64 (&h);
+
+	/* first, stat all files and combine the file-ids of the files that
+	 * belong to the same ifcfg file. */
+	full_paths = g_ptr_array_new_with_free_func (g_free);
+	files_hashes = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, g_free);
 
 	while ((f_filename = g_dir_read_name (dir))) {
 		gs_free char *full_path = NULL;
+		gs_free char *group = NULL;
+		guint64 *files_hash;
+
+		full_path = g_build_filename (IFCFG_DIR, f_filename, NULL);
+
+		group = _load_dir_files_group (full_path);
+		if (!group)
+			continue;
+
+		if (!nm_sett_util_file_id_stat (full_path, &file_id))
+			continue;
+
+		files_hash = g_hash_table_lookup (files_hashes, group);
+		if (!files_hash) {
+			files_hash = g_new (guint64, 1);
+			*files_hash = network_file_hash;
+			g_hash_table_insert (files_hashes, g_steal_pointer (&group), files_hash);
+		}
+
+		nm_hash_init (&h, 1267402311u);
+		nm_hash_update_str (&h, f_filename);
+		nm_sett_util_file_id_hash_update (&file_id, &h);
+		*files_hash ^= nm_hash_complete_u64 (&h);
+
+		g_ptr_array_add (full_paths, g_steal_pointer (&full_path));
+	}
+	g_dir_close (dir);
+
+	dupl_filenames = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
+
+	for (i = 0; i < full_paths->len; i++) {
 		NMSIfcfgRHStorage *storage;
+		const guint64 *files_hash;
 		char *full_filename;
 
-		full_path = g_build_filename (IFCFG_DIR, f_filename, NULL);
-		full_filename = utils_detect_ifcfg_path (full_path, TRUE);
+		full_filename = utils_detect_ifcfg_path (full_paths->pdata[i], TRUE);
 		if (!full_filename)
 			continue;
 
@@ -259,13 +327,28 @@ _load_dir (NMSIfcfgRHPlugin *self,
 
 		nm_assert (!nm_sett_util_storages_lookup_by_filename (storages, full_filename));
 
+		files_hash = g_hash_table_lookup (files_hashes, full_filename);
+
+		if (   storages_unchanged
+		    && files_hash
+		    && *files_hash != 0) {
+			storage = nm_sett_util_storages_lookup_by_filename (&priv->storages, full_filename);
+			if (   storage
+			    && storage->stat_files_hash == *files_hash) {
+				g_hash_table_add (storages_unchanged, storage);
+				continue;
+			}
+		}
+
 		storage = _load_file (self,
 		                      full_filename,
 		                      NULL);
-		if (storage)
-			nm_sett_util_storages_add_take (storages, storage);
+		if (!storage)
+			continue;
+
+		storage->stat_files_hash = files_hash ? *files_hash : 0;
+		nm_sett_util_storages_add_take (storages, storage);
 	}
-	g_dir_close (dir);
 }
 
 static void
@@ -273,6 +356,7 @@ _storages_consolidate (NMSIfcfgRHPlugin *self,
                        NMSettUtilStorages *storages_new,
                        gboolean replace_all,
                        GHashTable *storages_replaced,
+                       GHashTable *storages_unchanged,
                        NMSettingsPluginConnectionLoadCallback callback,
                        gpointer user_data)
 {
@@ -298,8 +382,11 @@ _storages_consolidate (NMSIfcfgRHPlugin *self,
 	storages_modified = g_ptr_array_new_with_free_func (g_object_unref);
 	c_list_init (&storages_deleted);
 
-	c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst)
-		storage_old->dirty = TRUE;
+	/* unchanged storages are neither reloaded nor pruned. */
+	c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst) {
+		storage_old->dirty =    !storages_unchanged
+		                     || !g_hash_table_contains (storages_unchanged, storage_old);
+	}
 
 	c_list_for_each_entry_safe (storage_new, storage_safe, &storages_new->_storage_lst_head, parent._storage_lst) {
 		storage_old = nm_sett_util_storages_lookup_by_filename (&priv->storages, nms_ifcfg_rh_storage_get_filename (storage_new));
@@ -535,6 +622,7 @@ load_connections (NMSettingsPlugin *plugin,
 	                       &storages_new,
 	                       FALSE,
 	                       storages_replaced,
+	                       NULL,
 	                       callback,
 	                       user_data);
 }
@@ -546,15 +634,23 @@ reload_connections (NMSettingsPlugin *plugin,
 {
 	NMSIfcfgRHPlugin *self = NMS_IFCFG_RH_PLUGIN (plugin);
 	nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new = NM_SETT_UTIL_STORAGES_INIT (storages_new, nms_ifcfg_rh_storage_destroy);
+	gs_unref_hashtable GHashTable *storages_unchanged = NULL;
 
 	nm_assert_self (self, TRUE);
 
-	_load_dir (self, &storages_new);
+	storages_unchanged = g_hash_table_new (nm_direct_hash, NULL);
+
+	_load_dir (self, &storages_new, storages_unchanged);
+
+	_LOGD ("reload: %u files reparsed, %u unchanged files skipped",
+	       g_hash_table_size (storages_new.idx_by_filename),
+	       g_hash_table_size (storages_unchanged));
 
 	_storages_consolidate (self,
 	                       &storages_new,
 	                       TRUE,
 	                       NULL,
+	                       storages_unchanged,
 	                       callback,
 	                       user_data);
 
@@ -705,6 +801,7 @@ update_connection (NMSettingsPlugin *plugin,
 	       nm_connection_get_id (connection));
 
 	storage->stat_mtime = *nm_sett_util_stat_mtime (full_filename, FALSE, &mtime);
+	storage->stat_files_hash = 0;
 
 	*out_storage = NM_SETTINGS_STORAGE (g_object_ref (storage));
 	*out_connection = g_steal_pointer (&reread);
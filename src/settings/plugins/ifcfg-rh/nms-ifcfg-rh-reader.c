@@ -5787,7 +5787,7 @@ connection_from_file_full (const char *filename,
 
 	/* Non-NULL only for unit tests; normally use /etc/sysconfig/network */
 	if (!network_file)
-		network_file = SYSCONFDIR "/sysconfig/network";
+		network_file = IFCFG_NETWORK_FILE;
 
 	ifcfg_name = utils_get_ifcfg_name (filename, TRUE);
 	if (!ifcfg_name) {
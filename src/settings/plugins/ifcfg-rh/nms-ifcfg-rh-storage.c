@@ -54,6 +54,7 @@ nms_ifcfg_rh_storage_copy_content (NMSIfcfgRHStorage *dst,
 	dst->unmanaged_spec    = g_strdup (src->unmanaged_spec);
 	dst->unrecognized_spec = g_strdup (src->unrecognized_spec);
 	dst->stat_mtime        = src->stat_mtime;
+	dst->stat_files_hash   = src->stat_files_hash;
 }
 
 NMConnection *
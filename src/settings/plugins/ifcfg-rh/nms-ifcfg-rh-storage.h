@@ -30,6 +30,11 @@ typedef struct {
 	 * higher priority. */
 	struct timespec stat_mtime;
 
+	/* A hash over the file-ids of the ifcfg file and the auxiliary files
+	 * that belong to it (keys, routes, rules and aliases). A reload skips
+	 * profiles where this is unchanged. Zero means unknown. */
+	guint64 stat_files_hash;
+
 	bool dirty:1;
 
 } NMSIfcfgRHStorage;
@@ -55,6 +55,12 @@ struct _shvarLine {
 	char *line;
 	char *key_with_prefix;
 
+	/* Lines parsed from a file don't own their strings, they point into
+	 * shvarFile.content. These flags are cleared once we allocate a
+	 * new string. */
+	bool line_borrowed:1;
+	bool key_borrowed:1;
+
 	/* svSetValue() will clear the dirty flag. */
 	bool dirty:1;
 };
@@ -63,6 +69,11 @@ typedef struct _shvarLine shvarLine;
 
 struct _shvarFile {
 	char *fileName;
+
+	/* the content of the file, split into NUL terminated lines. The
+	 * parsed lines point into this buffer. */
+	char *content;
+
 	CList lst_head;
 	GHashTable *lst_idx;
 	int fd;
@@ -71,7 +82,7 @@ struct _shvarFile {
 
 /*****************************************************************************/
 
-static void _line_link_parse (shvarFile *s, const char *value, gsize len);
+static void _line_link_parse (shvarFile *s, char *value, gsize len);
 
 /*****************************************************************************/
 
@@ -633,14 +644,14 @@ out_error:
 
 /*****************************************************************************/
 
-shvarFile *
-svFile_new (const char *name,
-            int fd,
-            const char *content)
+static shvarFile *
+_svFile_new_take (const char *name,
+                  int fd,
+                  char *content)
 {
 	shvarFile *s;
-	const char *p;
-	const char *q;
+	char *p;
+	char *q;
 
 	nm_assert (name);
 	nm_assert (fd >= -1);
@@ -648,14 +659,19 @@ svFile_new (const char *name,
 	s = g_slice_new (shvarFile);
 	*s = (shvarFile) {
 		.fileName = g_strdup (name),
+		.content  = content,
 		.fd       = fd,
 		.lst_head = C_LIST_INIT (s->lst_head),
 		.lst_idx  = g_hash_table_new (nm_pstr_hash, nm_pstr_equal),
 	};
 
 	if (content) {
-		for (p = content; (q = strchr (p, '\n')) != NULL; p = q + 1)
+		/* split the buffer in place. The lines reference it and
+		 * don't allocate their own copies. */
+		for (p = content; (q = strchr (p, '\n')) != NULL; p = q + 1) {
+			*q = '\0';
 			_line_link_parse (s, p, q - p);
+		}
 		if (p[0])
 			_line_link_parse (s, p, strlen (p));
 	}
@@ -663,6 +679,14 @@ svFile_new (const char *name,
 	return s;
 }
 
+shvarFile *
+svFile_new (const char *name,
+            int fd,
+            const char *content)
+{
+	return _svFile_new_take (name, fd, g_strdup (content));
+}
+
 const char *
 svFileGetName (const shvarFile *s)
 {
@@ -688,6 +712,23 @@ _nmtst_svFileSetModified (shvarFile *s)
 	s->modified = TRUE;
 }
 
+char *
+_nmtst_svFileDumpLines (const shvarFile *s)
+{
+	const shvarLine *line;
+	GString *str;
+
+	/* only for testing: show how the lines were parsed. */
+	str = g_string_new (NULL);
+	c_list_for_each_entry (line, &s->lst_head, lst) {
+		if (line->key)
+			g_string_append_printf (str, "[%s][%s][%s]\n", line->key_with_prefix, line->key, line->line ?: "");
+		else
+			g_string_append_printf (str, "[%s]\n", line->line ?: "");
+	}
+	return g_string_free (str, FALSE);
+}
+
 /*****************************************************************************/
 
 static void
@@ -712,17 +753,19 @@ ASSERT_shvarLine (const shvarLine *line)
 }
 
 static shvarLine *
-line_new_parse (const char *value, gsize len)
+line_new_parse (char *value, gsize len)
 {
 	shvarLine *line;
 	gsize k, e;
 
 	nm_assert (value);
+	nm_assert (value[len] == '\0');
 
 	line = g_slice_new (shvarLine);
 	*line = (shvarLine) {
-		.lst      = C_LIST_INIT (line->lst),
-		.dirty    = TRUE,
+		.lst           = C_LIST_INIT (line->lst),
+		.line_borrowed = TRUE,
+		.dirty         = TRUE,
 	};
 
 	for (k = 0; k < len; k++) {
@@ -734,9 +777,11 @@ line_new_parse (const char *value, gsize len)
 			for (e = k + 1; e < len; e++) {
 				if (value[e] == '=') {
 					nm_assert (_shell_is_name (&value[k], e - k));
-					line->line = g_strndup (&value[e + 1], len - e - 1);
-					line->key_with_prefix = g_strndup (value, e);
-					line->key = &line->key_with_prefix[k];
+					value[e] = '\0';
+					line->line = &value[e + 1];
+					line->key_with_prefix = value;
+					line->key = &value[k];
+					line->key_borrowed = TRUE;
 					ASSERT_shvarLine (line);
 					return line;
 				}
@@ -747,7 +792,7 @@ line_new_parse (const char *value, gsize len)
 		}
 		break;
 	}
-	line->line = g_strndup (value, len);
+	line->line = value;
 	ASSERT_shvarLine (line);
 	return line;
 }
@@ -774,6 +819,20 @@ line_new_build (const char *key, const char *value)
 	return line;
 }
 
+static gboolean
+line_clear_value (shvarLine *line)
+{
+	if (!line->line)
+		return FALSE;
+
+	if (line->line_borrowed)
+		line->line_borrowed = FALSE;
+	else
+		g_free (line->line);
+	line->line = NULL;
+	return TRUE;
+}
+
 static gboolean
 line_set (shvarLine *line, const char *value)
 {
@@ -786,6 +845,7 @@ line_set (shvarLine *line, const char *value)
 	line->dirty = FALSE;
 
 	if (line->key != line->key_with_prefix) {
+		/* also fine for a borrowed key, the string only gets shorter. */
 		memmove (line->key_with_prefix, line->key, strlen (line->key) + 1);
 		line->key = line->key_with_prefix;
 		changed = TRUE;
@@ -799,7 +859,7 @@ line_set (shvarLine *line, const char *value)
 			g_free (value_escaped);
 			return changed;
 		}
-		g_free (line->line);
+		line_clear_value (line);
 	}
 
 	line->line = value_escaped ?: g_strdup (value);
@@ -812,15 +872,17 @@ line_free (shvarLine *line)
 {
 	ASSERT_shvarLine (line);
 	c_list_unlink_stale (&line->lst);
-	g_free (line->line);
-	g_free (line->key_with_prefix);
+	if (!line->line_borrowed)
+		g_free (line->line);
+	if (!line->key_borrowed)
+		g_free (line->key_with_prefix);
 	g_slice_free (shvarLine, line);
 }
 
 /*****************************************************************************/
 
 static void
-_line_link_parse (shvarFile *s, const char *value, gsize len)
+_line_link_parse (shvarFile *s, char *value, gsize len)
 {
 	shvarLine *line;
 
@@ -908,11 +970,11 @@ svOpenFileInternal (const char *name, gboolean create, GError **error)
 	/* closefd is set if we opened the file read-only, so go ahead and
 	 * close it, because we can't write to it anyway */
 	nm_assert (closefd || fd >= 0);
-	return svFile_new (name,
-	                     !closefd
-	                   ? nm_steal_fd (&fd)
-	                   : -1,
-	                   content);
+	return _svFile_new_take (name,
+	                           !closefd
+	                         ? nm_steal_fd (&fd)
+	                         : -1,
+	                         g_steal_pointer (&content));
 }
 
 /* Open the file <name>, return shvarFile on success, NULL on failure */
@@ -1292,7 +1354,7 @@ svUnsetAll (shvarFile *s, SvKeyType match_key_type)
 		ASSERT_shvarLine (line);
 		if (   line->key
 		    && _svKeyMatchesType (line->key, match_key_type)) {
-			if (nm_clear_g_free (&line->line)) {
+			if (line_clear_value (line)) {
 				ASSERT_shvarLine (line);
 				changed = TRUE;
 			}
@@ -1322,7 +1384,7 @@ svUnsetDirtyWellknown (shvarFile *s, NMTernary new_dirty_value)
 		    && line->line
 		    && (ti = nms_ifcfg_rh_utils_is_well_known_key (line->key))
 		    && !NM_FLAGS_HAS (ti->key_flags, NMS_IFCFG_KEY_TYPE_KEEP_WHEN_DIRTY)) {
-			if (nm_clear_g_free (&line->line)) {
+			if (line_clear_value (line)) {
 				ASSERT_shvarLine (line);
 				changed = TRUE;
 			}
@@ -1372,7 +1434,7 @@ svSetValue (shvarFile *s, const char *key, const char *value)
 		if (line) {
 			/* We only clear the value, but leave the line entry. This way, if we
 			 * happen to re-add the value, we write it to the same line again. */
-			if (nm_clear_g_free (&line->line)) {
+			if (line_clear_value (line)) {
 				changed = TRUE;
 			}
 		}
@@ -1543,5 +1605,6 @@ svCloseFile (shvarFile *s)
 	g_hash_table_destroy (s->lst_idx);
 	while ((line = c_list_first_entry (&s->lst_head, shvarLine, lst)))
 		line_free (line);
+	g_free (s->content);
 	g_slice_free (shvarFile, s);
 }
@@ -23,6 +23,7 @@ const char *svFileGetName (const shvarFile *s);
 
 void _nmtst_svFileSetName (shvarFile *s, const char *fileName);
 void _nmtst_svFileSetModified (shvarFile *s);
+char *_nmtst_svFileDumpLines (const shvarFile *s);
 
 /*****************************************************************************/
 
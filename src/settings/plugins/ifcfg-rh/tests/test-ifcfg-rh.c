@@ -9535,6 +9535,155 @@ do_svUnescape_combine_ansi (GString *str_val, GString *str_exp, const UnescapeTe
 	g_string_append (str_val, "'");
 }
 
+static void
+_svFile_parse_reference_line (GString *str, const char *value, gsize len)
+{
+	gs_free char *line = NULL;
+	gsize k, e;
+
+	/* this is how shvar.c parsed a line before it split the file content
+	 * in place. Every line allocates its own strings. */
+	for (k = 0; k < len; k++) {
+		if (g_ascii_isspace (value[k]))
+			continue;
+
+		if (   g_ascii_isalpha (value[k])
+		    || value[k] == '_') {
+			for (e = k + 1; e < len; e++) {
+				if (value[e] == '=') {
+					gs_free char *key_with_prefix = g_strndup (value, e);
+
+					line = g_strndup (&value[e + 1], len - e - 1);
+					g_string_append_printf (str, "[%s][%s][%s]\n", key_with_prefix, &key_with_prefix[k], line);
+					return;
+				}
+				if (   !g_ascii_isalnum (value[e])
+				    && value[e] != '_')
+					break;
+			}
+		}
+		break;
+	}
+	line = g_strndup (value, len);
+	g_string_append_printf (str, "[%s]\n", line);
+}
+
+static char *
+_svFile_parse_reference (const char *content)
+{
+	GString *str = g_string_new (NULL);
+	const char *p;
+	const char *q;
+
+	for (p = content; (q = strchr (p, '\n')) != NULL; p = q + 1)
+		_svFile_parse_reference_line (str, p, q - p);
+	if (p[0])
+		_svFile_parse_reference_line (str, p, strlen (p));
+	return g_string_free (str, FALSE);
+}
+
+static void
+_svFile_assert_parse (const char *filename, const char *content, const char *expected)
+{
+	nm_auto_shvar_file_close shvarFile *f = NULL;
+	gs_free char *lines = NULL;
+	gs_free char *lines_reference = NULL;
+
+	f = svFile_new (filename, -1, content);
+	lines = _nmtst_svFileDumpLines (f);
+	lines_reference = _svFile_parse_reference (content);
+	g_assert_cmpstr (lines, ==, lines_reference);
+	if (expected)
+		g_assert_cmpstr (lines, ==, expected);
+}
+
+static void
+test_svFile_parse (void)
+{
+	_svFile_assert_parse ("/test/ifcfg-empty", "", "");
+	_svFile_assert_parse ("/test/ifcfg-parse",
+	                      "# comment\n"
+	                      "\n"
+	                      "KEY=value\n"
+	                      "  \tKEY2=\"a b\"\n"
+	                      "_K3=\n"
+	                      "no key=x\n"
+	                      "1KEY=x\n"
+	                      "KEY=dup\n"
+	                      "LAST=$'\\n'",
+	                      "[# comment]\n"
+	                      "[]\n"
+	                      "[KEY][KEY][value]\n"
+	                      "[  \tKEY2][KEY2][\"a b\"]\n"
+	                      "[_K3][_K3][]\n"
+	                      "[no key=x]\n"
+	                      "[1KEY=x]\n"
+	                      "[KEY][KEY][dup]\n"
+	                      "[LAST][LAST][$'\\n']\n");
+}
+
+static void
+test_svFile_corpus (void)
+{
+	gs_unref_ptrarray GPtrArray *filenames = g_ptr_array_new_with_free_func (g_free);
+	gs_unref_ptrarray GPtrArray *contents = g_ptr_array_new_with_free_func (g_free);
+	gs_free_error GError *error = NULL;
+	GDir *dir;
+	const char *name;
+	guint n_loops;
+	guint n_keys = 0;
+	guint i, j;
+
+	/* parse all files of the test corpus and compare the lines with
+	 * the previous parser. In performance mode (-m perf), this also
+	 * reports how long that takes. */
+	dir = g_dir_open (TEST_IFCFG_DIR, 0, &error);
+	nmtst_assert_success (dir, error);
+	while ((name = g_dir_read_name (dir))) {
+		if (   NM_STR_HAS_PREFIX (name, "ifcfg-")
+		    || NM_STR_HAS_PREFIX (name, "route")
+		    || NM_STR_HAS_PREFIX (name, "rule"))
+			g_ptr_array_add (filenames, g_build_filename (TEST_IFCFG_DIR, name, NULL));
+	}
+	g_dir_close (dir);
+	g_assert_cmpint (filenames->len, >, 0);
+
+	for (i = 0; i < filenames->len; i++) {
+		char *content;
+
+		if (!g_file_get_contents (filenames->pdata[i], &content, NULL, &error))
+			nmtst_assert_success (FALSE, error);
+		g_ptr_array_add (contents, content);
+		_svFile_assert_parse (filenames->pdata[i], content, NULL);
+	}
+
+	n_loops = g_test_perf () ? 200 : 1;
+
+	g_test_timer_start ();
+	for (j = 0; j < n_loops; j++) {
+		for (i = 0; i < filenames->len; i++) {
+			nm_auto_shvar_file_close shvarFile *f = NULL;
+			gs_free const char **keys = NULL;
+			guint keys_len = 0;
+
+			f = _svOpenFile (filenames->pdata[i]);
+			keys = svGetKeysSorted (f, SV_KEY_TYPE_ANY, &keys_len);
+			if (j == 0)
+				n_keys += keys_len;
+		}
+	}
+
+	if (g_test_perf ()) {
+		g_test_minimized_result (g_test_timer_elapsed (),
+		                         "parsed %u files %u times: %f seconds",
+		                         filenames->len,
+		                         n_loops,
+		                         g_test_timer_last ());
+	}
+
+	g_assert_cmpint (n_keys, >, 0);
+}
+
 static void
 test_svUnescape (void)
 {
@@ -10417,6 +10566,8 @@ int main (int argc, char **argv)
 	}
 
 	g_test_add_func (TPATH "svUnescape", test_svUnescape);
+	g_test_add_func (TPATH "svFile-parse", test_svFile_parse);
+	g_test_add_func (TPATH "svFile-corpus", test_svFile_corpus);
 
 	g_test_add_data_func (TPATH "write-unknown/1", TEST_IFCFG_DIR"/ifcfg-test-write-unknown-1", test_write_unknown);
 	g_test_add_data_func (TPATH "write-unknown/2", TEST_IFCFG_DIR"/ifcfg-test-write-unknown-2", test_write_unknown);
@@ -61,6 +61,13 @@ typedef struct {
 
 	NMSettUtilStorages storages;
 
+	/* with monitor-connection-files, we watch the keyfile directories and
+	 * collect the changed filenames until the debounce timeout expires. */
+	GFileMonitor *monitors[3]; /* the entries of dirname_libs, dirname_etc and dirname_run */
+	GHashTable *monitor_changed_filenames;
+	gint64 monitor_first_change_msec;
+	guint monitor_timeout_id;
+
 } NMSKeyfilePluginPrivate;
 
 struct _NMSKeyfilePlugin {
@@ -275,6 +282,85 @@ _nm_assert_storage (gpointer plugin  /* NMSKeyfilePlugin  */,
 
 /*****************************************************************************/
 
+/* Directories with at least this many files get parsed on a pool
+ * of worker threads. */
+#define LOAD_DIR_THREADS_MIN_FILES 32
+#define LOAD_DIR_THREADS_MAX       8
+
+typedef struct {
+	char *full_filename;
+	const char *plugin_dir;
+	NMConnection *connection;
+	GError *error;
+	char *shadowed_storage;
+	struct stat st;
+	NMTernary is_nm_generated_opt;
+	NMTernary is_volatile_opt;
+	NMTernary shadowed_owned_opt;
+} LoadFileReadData;
+
+/* This may be called on a worker thread. It must only touch @rd.
+ *
+ * Besides @rd, reading and normalizing a profile touches process-global
+ * state only via:
+ *  - the crypto backend, when verifying 802.1X certificates and keys.
+ *    _nm_crypto_init() serializes the initialization.
+ *  - logging the warnings of the reader. nm_log() may be called from
+ *    other threads.
+ *  - GType class initialization, the hash seed and the random number
+ *    generator. These are thread-safe. */
+static void
+_load_file_read (LoadFileReadData *rd)
+{
+	rd->connection = _read_from_file (rd->full_filename,
+	                                  rd->plugin_dir,
+	                                  &rd->st,
+	                                  &rd->is_nm_generated_opt,
+	                                  &rd->is_volatile_opt,
+	                                  &rd->shadowed_storage,
+	                                  &rd->shadowed_owned_opt,
+	                                  &rd->error);
+}
+
+static void
+_load_file_read_thread_fn (gpointer data, gpointer user_data)
+{
+	_load_file_read (data);
+}
+
+static NMSKeyfileStorage *
+_load_file_read_finish (NMSKeyfilePlugin *self,
+                        LoadFileReadData *rd,
+                        NMSKeyfileStorageType storage_type,
+                        GError **error)
+{
+	gs_unref_object NMConnection *connection = g_steal_pointer (&rd->connection);
+	gs_free_error GError *local = g_steal_pointer (&rd->error);
+	gs_free char *full_filename = g_steal_pointer (&rd->full_filename);
+	gs_free char *shadowed_storage = g_steal_pointer (&rd->shadowed_storage);
+	NMSKeyfileStorage *storage;
+
+	if (!connection) {
+		if (error)
+			g_propagate_error (error, g_steal_pointer (&local));
+		else
+			_LOGW ("load: \"%s\": failed to load connection: %s", full_filename, local->message);
+		return NULL;
+	}
+
+	storage = nms_keyfile_storage_new_connection (self,
+	                                              g_steal_pointer (&connection),
+	                                              full_filename,
+	                                              storage_type,
+	                                              rd->is_nm_generated_opt,
+	                                              rd->is_volatile_opt,
+	                                              shadowed_storage,
+	                                              rd->shadowed_owned_opt,
+	                                              &rd->st.st_mtim);
+	nm_sett_util_file_id_init (&storage->file_id, &rd->st);
+	return storage;
+}
+
 static NMSKeyfileStorage *
 _load_file (NMSKeyfilePlugin *self,
             const char *dirname,
@@ -282,17 +368,11 @@ _load_file (NMSKeyfilePlugin *self,
             NMSKeyfileStorageType storage_type,
             GError **error)
 {
-	NMSKeyfilePluginPrivate *priv;
-	gs_unref_object NMConnection *connection = NULL;
-	NMTernary is_volatile_opt;
-	NMTernary is_nm_generated_opt;
-	NMTernary shadowed_owned_opt;
-	gs_free char *shadowed_storage = NULL;
-	gs_free_error GError *local = NULL;
-	gs_free char *full_filename = NULL;
-	struct stat st;
+	LoadFileReadData rd = { };
 
 	if (_ignore_filename (storage_type, filename)) {
+		NMSKeyfileStorage *storage;
+		gs_free char *full_filename = NULL;
 		gs_free char *nmmeta = NULL;
 		gs_free char *loaded_path = NULL;
 		gs_free char *shadowed_storage_filename = NULL;
@@ -334,42 +414,19 @@ _load_file (NMSKeyfilePlugin *self,
 			return NULL;
 		}
 
-		return nms_keyfile_storage_new_tombstone (self,
-		                                          nmmeta,
-		                                          full_filename,
-		                                          storage_type,
-		                                          shadowed_storage_filename);
-	}
-
-	full_filename = g_build_filename (dirname, filename, NULL);
-
-	priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
-
-	connection = _read_from_file (full_filename,
-	                              _get_plugin_dir (priv),
-	                              &st,
-	                              &is_nm_generated_opt,
-	                              &is_volatile_opt,
-	                              &shadowed_storage,
-	                              &shadowed_owned_opt,
-	                              &local);
-	if (!connection) {
-		if (error)
-			g_propagate_error (error, g_steal_pointer (&local));
-		else
-			_LOGW ("load: \"%s\": failed to load connection: %s", full_filename, local->message);
-		return NULL;
+		storage = nms_keyfile_storage_new_tombstone (self,
+		                                             nmmeta,
+		                                             full_filename,
+		                                             storage_type,
+		                                             shadowed_storage_filename);
+		nm_sett_util_file_id_lstat (full_filename, &storage->file_id);
+		return storage;
 	}
 
-	return nms_keyfile_storage_new_connection (self,
-	                                           g_steal_pointer (&connection),
-	                                           full_filename,
-	                                           storage_type,
-	                                           is_nm_generated_opt,
-	                                           is_volatile_opt,
-	                                           shadowed_storage,
-	                                           shadowed_owned_opt,
-	                                           &st.st_mtim);
+	rd.full_filename = g_build_filename (dirname, filename, NULL);
+	rd.plugin_dir = _get_plugin_dir (NMS_KEYFILE_PLUGIN_GET_PRIVATE (self));
+	_load_file_read (&rd);
+	return _load_file_read_finish (self, &rd, storage_type, error);
 }
 
 static NMSKeyfileStorage *
@@ -394,42 +451,127 @@ _load_file_from_path (NMSKeyfilePlugin *self,
 	                   error);
 }
 
+static gboolean
+_load_file_is_unchanged (NMSKeyfilePlugin *self,
+                         const char *full_filename,
+                         GHashTable *storages_unchanged)
+{
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	NMSKeyfileStorage *storage;
+	NMSettUtilFileId file_id;
+
+	storage = nm_sett_util_storages_lookup_by_filename (&priv->storages, full_filename);
+	if (   !storage
+	    || !nm_sett_util_file_id_is_set (&storage->file_id))
+		return FALSE;
+
+	if (storage->is_meta_data) {
+		if (!nm_sett_util_file_id_lstat (full_filename, &file_id))
+			return FALSE;
+	} else {
+		if (!nm_sett_util_file_id_stat (full_filename, &file_id))
+			return FALSE;
+	}
+	if (!nm_sett_util_file_id_equal (&file_id, &storage->file_id))
+		return FALSE;
+
+	if (storages_unchanged)
+		g_hash_table_add (storages_unchanged, storage);
+	return TRUE;
+}
+
 static void
 _load_dir (NMSKeyfilePlugin *self,
            NMSKeyfileStorageType storage_type,
            const char *dirname,
-           NMSettUtilStorages *storages)
+           NMSettUtilStorages *storages,
+           GHashTable *storages_unchanged)
 {
 	const char *filename;
 	GDir *dir;
 	gs_unref_hashtable GHashTable *dupl_filenames = NULL;
+	gs_unref_ptrarray GPtrArray *filenames = NULL;
+	gs_free LoadFileReadData *read_data = NULL;
+	guint i;
 
 	dir = g_dir_open (dirname, 0, NULL);
 	if (!dir)
 		return;
 
-	dupl_filenames = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
+	dupl_filenames = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	filenames = g_ptr_array_new ();
 
 	while ((filename = g_dir_read_name (dir))) {
-		gs_unref_object NMSKeyfileStorage *storage = NULL;
+		char *f;
 
-		filename = g_strdup (filename);
-		if (!g_hash_table_add (dupl_filenames, (char *) filename))
+		if (g_hash_table_contains (dupl_filenames, filename))
 			continue;
+		f = g_strdup (filename);
+		g_hash_table_add (dupl_filenames, f);
 
-		storage = _load_file (self,
-		                      dirname,
-		                      filename,
-		                      storage_type,
-		                      NULL);
+		/* skip files that we already track, and that did not change since
+		 * we last read them. This includes the .nmmeta files. */
+		if (storages_unchanged) {
+			gs_free char *full_filename = g_build_filename (dirname, f, NULL);
+
+			if (_load_file_is_unchanged (self, full_filename, storages_unchanged))
+				continue;
+		}
+
+		g_ptr_array_add (filenames, f);
+	}
+
+	g_dir_close (dir);
+
+	if (filenames->len >= LOAD_DIR_THREADS_MIN_FILES) {
+		GThreadPool *pool;
+
+		/* Reading and normalizing the profiles is the expensive part. For large
+		 * directories, do that in parallel on a pool of worker threads. The storages
+		 * are created afterwards on the main thread, in the order of the directory
+		 * listing, so that the result is the same as when loading sequentially. */
+		pool = g_thread_pool_new (_load_file_read_thread_fn,
+		                          NULL,
+		                          NM_CLAMP ((int) g_get_num_processors (), 1, LOAD_DIR_THREADS_MAX),
+		                          TRUE,
+		                          NULL);
+		if (pool) {
+			const char *plugin_dir = _get_plugin_dir (NMS_KEYFILE_PLUGIN_GET_PRIVATE (self));
+
+			read_data = g_new0 (LoadFileReadData, filenames->len);
+			for (i = 0; i < filenames->len; i++) {
+				if (_ignore_filename (storage_type, filenames->pdata[i]))
+					continue;
+				read_data[i].full_filename = g_build_filename (dirname, filenames->pdata[i], NULL);
+				read_data[i].plugin_dir = plugin_dir;
+				g_thread_pool_push (pool, &read_data[i], NULL);
+			}
+			g_thread_pool_free (pool, FALSE, TRUE);
+		}
+	}
+
+	for (i = 0; i < filenames->len; i++) {
+		gs_unref_object NMSKeyfileStorage *storage = NULL;
+
+		if (   read_data
+		    && read_data[i].full_filename) {
+			storage = _load_file_read_finish (self,
+			                                  &read_data[i],
+			                                  storage_type,
+			                                  NULL);
+		} else {
+			storage = _load_file (self,
+			                      dirname,
+			                      filenames->pdata[i],
+			                      storage_type,
+			                      NULL);
+		}
 		if (!storage)
 			continue;
 
 		nm_sett_util_storages_add_take (storages, g_steal_pointer (&storage));
 	}
 
-	g_dir_close (dir);
-
 #if NM_MORE_ASSERTS
 	{
 		NMSKeyfileStorage *storage;
@@ -447,6 +589,7 @@ _storages_consolidate (NMSKeyfilePlugin *self,
                        NMSettUtilStorages *storages_new,
                        gboolean replace_all,
                        GHashTable *storages_replaced,
+                       GHashTable *storages_unchanged,
                        NMSettingsPluginConnectionLoadCallback callback,
                        gpointer user_data)
 {
@@ -463,8 +606,11 @@ _storages_consolidate (NMSKeyfilePlugin *self,
 	storages_modified = g_ptr_array_new_with_free_func (g_object_unref);
 	c_list_init (&storages_deleted);
 
-	c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst)
-		storage_old->is_dirty = TRUE;
+	/* unchanged storages are neither reloaded nor pruned. */
+	c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst) {
+		storage_old->is_dirty =    !storages_unchanged
+		                        || !g_hash_table_contains (storages_unchanged, storage_old);
+	}
 
 	c_list_for_each_entry_safe (storage_new, storage_safe, &storages_new->_storage_lst_head, parent._storage_lst) {
 		storage_old = nm_sett_util_storages_lookup_by_filename (&priv->storages, nms_keyfile_storage_get_filename (storage_new));
@@ -554,18 +700,26 @@ reload_connections (NMSettingsPlugin *plugin,
 	NMSKeyfilePlugin *self = NMS_KEYFILE_PLUGIN (plugin);
 	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
 	nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new = NM_SETT_UTIL_STORAGES_INIT (storages_new, nms_keyfile_storage_destroy);
+	gs_unref_hashtable GHashTable *storages_unchanged = NULL;
 	int i;
 
-	_load_dir (self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new);
+	storages_unchanged = g_hash_table_new (nm_direct_hash, NULL);
+
+	_load_dir (self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new, storages_unchanged);
 	if (priv->dirname_etc)
-		_load_dir (self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new);
+		_load_dir (self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new, storages_unchanged);
 	for (i = 0; priv->dirname_libs[i]; i++)
-		_load_dir (self, NMS_KEYFILE_STORAGE_TYPE_LIB (i), priv->dirname_libs[i], &storages_new);
+		_load_dir (self, NMS_KEYFILE_STORAGE_TYPE_LIB (i), priv->dirname_libs[i], &storages_new, storages_unchanged);
+
+	_LOGD ("reload: %u files reparsed, %u unchanged files skipped",
+	       g_hash_table_size (storages_new.idx_by_filename),
+	       g_hash_table_size (storages_unchanged));
 
 	_storages_consolidate (self,
 	                       &storages_new,
 	                       TRUE,
 	                       NULL,
+	                       storages_unchanged,
 	                       callback,
 	                       user_data);
 }
@@ -722,6 +876,7 @@ load_connections (NMSettingsPlugin *plugin,
 	                       &storages_new,
 	                       FALSE,
 	                       storages_replaced,
+	                       NULL,
 	                       callback,
 	                       user_data);
 }
@@ -819,6 +974,7 @@ nms_keyfile_plugin_add_connection (NMSKeyfilePlugin *self,
 	                                              shadowed_storage,
 	                                              shadowed_owned ? NM_TERNARY_TRUE : NM_TERNARY_FALSE,
 	                                              nm_sett_util_stat_mtime (full_filename, FALSE, &mtime));
+	nm_sett_util_file_id_stat (full_filename, &storage->file_id);
 
 	nm_sett_util_storages_add_take (&priv->storages, g_object_ref (storage));
 
@@ -939,6 +1095,7 @@ nms_keyfile_plugin_update_connection (NMSKeyfilePlugin *self,
 	storage->u.conn_data.is_nm_generated = is_nm_generated;
 	storage->u.conn_data.is_volatile     = is_volatile;
 	storage->u.conn_data.stat_mtime      = *nm_sett_util_stat_mtime (full_filename, FALSE, &mtime);
+	nm_sett_util_file_id_stat (full_filename, &storage->file_id);
 	storage->u.conn_data.shadowed_owned  = shadowed_owned;
 
 	*out_storage = g_object_ref (NM_SETTINGS_STORAGE (storage));
@@ -1157,6 +1314,8 @@ nms_keyfile_plugin_set_nmmeta_tombstone (NMSKeyfilePlugin *self,
 			g_free (storage->u.meta_data.shadowed_storage);
 			storage->u.meta_data.shadowed_storage = g_strdup (shadowed_storage);
 		}
+		if (!simulate)
+			nm_sett_util_file_id_lstat (nmmeta_filename, &storage->file_id);
 
 		storage_result = g_object_ref (storage);
 	} else {
@@ -1176,6 +1335,187 @@ out:
 
 /*****************************************************************************/
 
+/* after a change, wait this long for more changes before loading the files. */
+#define MONITOR_DEBOUNCE_MSEC     500
+
+/* but don't postpone loading files for longer than this. */
+#define MONITOR_DEBOUNCE_MAX_MSEC 5000
+
+static gboolean
+_monitor_timeout_cb (gpointer user_data)
+{
+	NMSKeyfilePlugin *self = user_data;
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	gs_unref_hashtable GHashTable *changed_filenames = NULL;
+	gs_unref_ptrarray GPtrArray *filenames = NULL;
+	GHashTableIter h_iter;
+	const char *full_filename;
+	guint n_unchanged = 0;
+
+	priv->monitor_timeout_id = 0;
+	changed_filenames = g_steal_pointer (&priv->monitor_changed_filenames);
+
+	if (!changed_filenames)
+		return G_SOURCE_REMOVE;
+
+	filenames = g_ptr_array_new ();
+
+	g_hash_table_iter_init (&h_iter, changed_filenames);
+	while (g_hash_table_iter_next (&h_iter, (gpointer *) &full_filename, NULL)) {
+		/* ignore files that we wrote ourselves, or that were only touched. */
+		if (_load_file_is_unchanged (self, full_filename, NULL)) {
+			n_unchanged++;
+			continue;
+		}
+		g_ptr_array_add (filenames, (char *) full_filename);
+	}
+
+	_LOGD ("monitor: %u files changed, %u unchanged files skipped",
+	       filenames->len,
+	       n_unchanged);
+
+	if (filenames->len == 0)
+		return G_SOURCE_REMOVE;
+
+	g_ptr_array_sort (filenames, nm_strcmp_p);
+	g_ptr_array_add (filenames, NULL);
+
+	_nm_settings_plugin_emit_signal_connection_files_changed (NM_SETTINGS_PLUGIN (self),
+	                                                         (const char *const*) filenames->pdata);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+_monitor_add_file (NMSKeyfilePlugin *self,
+                   GFile *file)
+{
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	char *full_filename;
+	gint64 now_msec;
+
+	if (!file)
+		return;
+
+	full_filename = g_file_get_path (file);
+	if (!full_filename)
+		return;
+
+	/* skip files that we would not load anyway, like temporary files of
+	 * editors or of our own writer, and backup files. */
+	if (!_path_detect_storage_type (full_filename,
+	                                (const char *const*) priv->dirname_libs,
+	                                priv->dirname_etc,
+	                                priv->dirname_run,
+	                                NULL,
+	                                NULL,
+	                                NULL,
+	                                NULL,
+	                                NULL)) {
+		g_free (full_filename);
+		return;
+	}
+
+	if (!priv->monitor_changed_filenames)
+		priv->monitor_changed_filenames = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_add (priv->monitor_changed_filenames, full_filename);
+
+	now_msec = nm_utils_get_monotonic_timestamp_msec ();
+
+	if (!priv->monitor_timeout_id)
+		priv->monitor_first_change_msec = now_msec;
+	else if (now_msec - priv->monitor_first_change_msec >= MONITOR_DEBOUNCE_MAX_MSEC - MONITOR_DEBOUNCE_MSEC) {
+		/* we postponed long enough. Let the pending timeout fire. */
+		return;
+	}
+
+	nm_clear_g_source (&priv->monitor_timeout_id);
+	priv->monitor_timeout_id = g_timeout_add (MONITOR_DEBOUNCE_MSEC, _monitor_timeout_cb, self);
+}
+
+static void
+_monitor_changed_cb (GFileMonitor *monitor,
+                     GFile *file,
+                     GFile *other_file,
+                     GFileMonitorEvent event_type,
+                     gpointer user_data)
+{
+	NMSKeyfilePlugin *self = user_data;
+
+	switch (event_type) {
+	case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
+	case G_FILE_MONITOR_EVENT_CREATED:
+	case G_FILE_MONITOR_EVENT_DELETED:
+	case G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED:
+	case G_FILE_MONITOR_EVENT_MOVED_IN:
+	case G_FILE_MONITOR_EVENT_MOVED_OUT:
+		_monitor_add_file (self, file);
+		break;
+	case G_FILE_MONITOR_EVENT_RENAMED:
+		_monitor_add_file (self, file);
+		_monitor_add_file (self, other_file);
+		break;
+	default:
+		/* G_FILE_MONITOR_EVENT_CHANGED is followed by a CHANGES_DONE_HINT,
+		 * once the writer closes the file. */
+		break;
+	}
+}
+
+static void
+_monitor_start (NMSKeyfilePlugin *self)
+{
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	const char *dirnames[G_N_ELEMENTS (priv->monitors)] = { };
+	guint n_dirnames = 0;
+	guint i;
+
+	G_STATIC_ASSERT (G_N_ELEMENTS (priv->monitors) == (G_N_ELEMENTS (priv->dirname_libs) - 1) + 2);
+
+	for (i = 0; priv->dirname_libs[i]; i++)
+		dirnames[n_dirnames++] = priv->dirname_libs[i];
+	dirnames[n_dirnames++] = priv->dirname_etc;
+	dirnames[n_dirnames++] = priv->dirname_run;
+
+	for (i = 0; i < n_dirnames; i++) {
+		gs_unref_object GFile *file = NULL;
+		gs_free_error GError *error = NULL;
+
+		if (!dirnames[i])
+			continue;
+
+		file = g_file_new_for_path (dirnames[i]);
+		priv->monitors[i] = g_file_monitor_directory (file, G_FILE_MONITOR_WATCH_MOVES, NULL, &error);
+		if (!priv->monitors[i]) {
+			_LOGW ("monitor: failure to monitor \"%s\": %s", dirnames[i], error->message);
+			continue;
+		}
+
+		g_signal_connect (priv->monitors[i], "changed",
+		                  G_CALLBACK (_monitor_changed_cb), self);
+		_LOGD ("monitor: watching \"%s\" for changes", dirnames[i]);
+	}
+}
+
+static void
+_monitor_stop (NMSKeyfilePlugin *self)
+{
+	NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE (self);
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (priv->monitors); i++) {
+		if (!priv->monitors[i])
+			continue;
+		g_signal_handlers_disconnect_by_func (priv->monitors[i], _monitor_changed_cb, self);
+		g_file_monitor_cancel (priv->monitors[i]);
+		g_clear_object (&priv->monitors[i]);
+	}
+
+	nm_clear_g_source (&priv->monitor_timeout_id);
+	nm_clear_pointer (&priv->monitor_changed_filenames, g_hash_table_destroy);
+}
+
+/*****************************************************************************/
+
 static void
 config_changed_cb (NMConfig *config,
                    NMConfigData *config_data,
@@ -1269,7 +1609,13 @@ constructed (GObject *object)
 	                              NM_CONFIG_KEYFILE_GROUP_MAIN,
 	                              NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES,
 	                              NM_CONFIG_GET_VALUE_RAW))
-		_LOGW ("'monitor-connection-files' option is deprecated and has no effect");
+		_LOGW ("'monitor-connection-files' option in [main] is deprecated and has no effect. Set it in [keyfile] instead");
+
+	if (nm_config_data_get_value_boolean (nm_config_get_data_orig (priv->config),
+	                                      NM_CONFIG_KEYFILE_GROUP_KEYFILE,
+	                                      NM_CONFIG_KEYFILE_KEY_KEYFILE_MONITOR_CONNECTION_FILES,
+	                                      FALSE))
+		_monitor_start (self);
 
 	g_signal_connect (G_OBJECT (priv->config),
 	                  NM_CONFIG_SIGNAL_CONFIG_CHANGED,
@@ -1292,6 +1638,8 @@ dispose (GObject *object)
 	if (priv->config)
 		g_signal_handlers_disconnect_by_func (priv->config, config_changed_cb, object);
 
+	_monitor_stop (self);
+
 	nm_sett_util_storages_clear (&priv->storages);
 
 	nm_clear_g_free (&priv->dirname_libs[0]);
@@ -32,6 +32,8 @@ nms_keyfile_storage_copy_content (NMSKeyfileStorage *dst,
 	nm_assert (dst->storage_type == src->storage_type);
 	nm_assert (dst->is_meta_data == src->is_meta_data);
 
+	dst->file_id = src->file_id;
+
 	if (dst->is_meta_data) {
 		gs_free char *shadowed_storage_to_free = NULL;
 
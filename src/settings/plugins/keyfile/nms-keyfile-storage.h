@@ -8,6 +8,7 @@
 
 #include "c-list/src/c-list.h"
 #include "settings/nm-settings-storage.h"
+#include "settings/nm-settings-utils.h"
 #include "nms-keyfile-utils.h"
 
 /*****************************************************************************/
@@ -81,6 +82,11 @@ typedef struct {
 
 	} u;
 
+	/* the file-id of the keyfile or .nmmeta file when we last read or wrote
+	 * it. A reload skips files whose file-id did not change. For .nmmeta
+	 * files, which usually are symlinks, this is the file-id of the link. */
+	NMSettUtilFileId file_id;
+
 	/* The storage type. This is directly related to the filename. Since
 	 * the filename cannot change, this value is unchanging. */
 	const NMSKeyfileStorageType storage_type;
@@ -17,6 +17,7 @@
 #include "nm-setting-wireless.h"
 #include "nm-setting-wireless-security.h"
 #include "nm-config.h"
+#include "settings/nm-settings-utils.h"
 
 /*****************************************************************************/
 
@@ -255,12 +256,12 @@ nms_keyfile_nmmeta_write (const char *dirname,
 
 		contents = g_key_file_to_data (kf, &length, NULL);
 
-		if (!nm_utils_file_set_contents (full_filename,
-		                                 contents,
-		                                 length,
-		                                 0600,
-		                                 &errsv,
-		                                 NULL)) {
+		if (!nm_sett_util_file_set_contents (full_filename,
+		                                     contents,
+		                                     length,
+		                                     0600,
+		                                     &errsv,
+		                                     NULL)) {
 			NM_SET_OUT (out_full_filename, g_steal_pointer (&full_filename_tmp));
 			return -NM_ERRNO_NATIVE (errsv);
 		}
@@ -18,6 +18,7 @@
 #include "nms-keyfile-reader.h"
 
 #include "nm-glib-aux/nm-io-utils.h"
+#include "settings/nm-settings-utils.h"
 
 /*****************************************************************************/
 
@@ -116,12 +117,12 @@ cert_writer (NMConnection *connection,
 		 * being sure that the entire profile can be written and all circumstances are good to
 		 * proceed. That means, while writing we must only collect the blogs in-memory, and write
 		 * them all in the end together (or not at all). */
-		success = nm_utils_file_set_contents (new_path,
-		                                      (const char *) blob_data,
-		                                      blob_len,
-		                                      0600,
-		                                      NULL,
-		                                      &local);
+		success = nm_sett_util_file_set_contents (new_path,
+		                                          (const char *) blob_data,
+		                                          blob_len,
+		                                          0600,
+		                                          NULL,
+		                                          &local);
 		if (success) {
 			/* Write the path value to the keyfile.
 			 * We know, that basename(new_path) starts with a UUID, hence no conflict with "data:;base64,"  */
@@ -334,12 +335,12 @@ _internal_write_connection (NMConnection *connection,
 		}
 	}
 
-	nm_utils_file_set_contents (path,
-	                            kf_content_buf,
-	                            kf_content_len,
-	                            0600,
-	                            NULL,
-	                            &local_err);
+	nm_sett_util_file_set_contents (path,
+	                                kf_content_buf,
+	                                kf_content_len,
+	                                0600,
+	                                NULL,
+	                                &local_err);
 	if (local_err) {
 		g_set_error (error, NM_SETTINGS_ERROR, NM_SETTINGS_ERROR_FAILED,
 		             "error writing to file '%s': %s",
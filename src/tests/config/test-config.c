@@ -208,6 +208,89 @@ test_config_simple (void)
 	g_free (value);
 }
 
+#define BENCH_N_SECTIONS 25
+#define BENCH_N_REPEAT   3
+
+/* The device cache of NMConfigData holds up to 1024 entries. Run once with
+ * fewer devices and once with more devices than that, so that the latter
+ * exercises the eviction of entries. */
+static void
+test_config_device_cache (gconstpointer test_data)
+{
+	const guint n_devices = GPOINTER_TO_UINT (test_data);
+	gs_unref_object NMConfig *config = NULL;
+	gs_unref_ptrarray GPtrArray *devices = g_ptr_array_new_with_free_func (g_object_unref);
+	nm_auto_free_gstring GString *contents = g_string_new ("[main]\nplugins=foo\n");
+	const char *CONFIG_FILE = BUILD_DIR"/test-device-cache.conf";
+	const NMConfigData *config_data;
+	guint n_loops;
+	guint i, j, k;
+	char sbuf[30];
+
+	/* @BENCH_N_SECTIONS [connection*] and as many [device*] sections. Each
+	 * matches the MAC addresses of n_devices/BENCH_N_SECTIONS devices. */
+	for (k = 0; k < 2; k++) {
+		for (j = 0; j < BENCH_N_SECTIONS; j++) {
+			g_string_append_printf (contents,
+			                        "\n[%s.bench-%02u]\nmatch-device=",
+			                        k == 0 ? "connection" : "device",
+			                        j);
+			for (i = j; i < n_devices; i += BENCH_N_SECTIONS)
+				g_string_append_printf (contents, "%smac:00:00:00:00:%02x:%02x", i == j ? "" : ",", i >> 8, i & 0xFF);
+			g_string_append_printf (contents,
+			                        "\n%s=%u\n",
+			                        k == 0 ? "ipv4.route-metric" : NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT,
+			                        j);
+		}
+	}
+	g_assert (g_file_set_contents (CONFIG_FILE, contents->str, contents->len, NULL));
+
+	config = setup_config (NULL, CONFIG_FILE, "", NULL, "/no/such/dir", "", NULL);
+	config_data = nm_config_get_data_orig (config);
+
+	for (i = 0; i < n_devices; i++)
+		g_ptr_array_add (devices, nm_test_device_new (nm_sprintf_buf (sbuf, "00:00:00:00:%02x:%02x", i >> 8, i & 0xFF)));
+
+	/* Each pass looks up every device BENCH_N_REPEAT times in a row, like
+	 * during activation. The first lookup of a device in a pass is a cache
+	 * miss if the device got evicted. Print the time of every pass, and
+	 * in performance mode (-m perf) do more passes. */
+	n_loops = g_test_perf () ? 50 : 3;
+
+	for (k = 0; k < n_loops; k++) {
+		g_test_timer_start ();
+		for (i = 0; i < n_devices; i++) {
+			nm_sprintf_buf (sbuf, "%u", i % BENCH_N_SECTIONS);
+			for (j = 0; j < BENCH_N_REPEAT; j++) {
+				gs_free char *value1 = NULL;
+				gs_free char *value2 = NULL;
+
+				value1 = nm_config_data_get_connection_default (config_data, "ipv4.route-metric", devices->pdata[i]);
+				value2 = nm_config_data_get_device_config (config_data, NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT, devices->pdata[i], NULL);
+				g_assert_cmpstr (value1, ==, sbuf);
+				g_assert_cmpstr (value2, ==, sbuf);
+			}
+		}
+		g_test_timer_elapsed ();
+		g_test_message ("pass %u: %u lookups for %u devices and %u sections: %f seconds",
+		                k,
+		                2 * BENCH_N_REPEAT * n_devices,
+		                n_devices,
+		                2 * BENCH_N_SECTIONS,
+		                g_test_timer_last ());
+		if (g_test_perf ()) {
+			g_test_minimized_result (g_test_timer_last (),
+			                         "%s lookup for %u devices and %u sections: %f seconds",
+			                         k == 0 ? "first" : "cached",
+			                         n_devices,
+			                         2 * BENCH_N_SECTIONS,
+			                         g_test_timer_last ());
+		}
+	}
+
+	g_assert (remove (CONFIG_FILE) == 0);
+}
+
 static void
 test_config_non_existent (void)
 {
@@ -1074,6 +1157,8 @@ main (int argc, char **argv)
 	nm_fake_platform_setup ();
 
 	g_test_add_func ("/config/simple", test_config_simple);
+	g_test_add_data_func ("/config/device-cache/1000", GUINT_TO_POINTER (1000), test_config_device_cache);
+	g_test_add_data_func ("/config/device-cache/3000", GUINT_TO_POINTER (3000), test_config_device_cache);
 	g_test_add_func ("/config/non-existent", test_config_non_existent);
 	g_test_add_func ("/config/parse-error", test_config_parse_error);
 	g_test_add_func ("/config/no-auto-default", test_config_no_auto_default);
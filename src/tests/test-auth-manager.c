@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright (C) 2020 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include <unistd.h>
+
+#include "nm-auth-manager.h"
+#include "nm-dbus-manager.h"
+#include "nm-libnm-core-intern/nm-auth-subject.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+#define POLKIT_SERVICE     "org.freedesktop.PolicyKit1"
+#define POLKIT_OBJECT_PATH "/org/freedesktop/PolicyKit1/Authority"
+#define POLKIT_INTERFACE   "org.freedesktop.PolicyKit1.Authority"
+
+static const char *const polkit_introspection_xml =
+	"<node>"
+	"  <interface name='" POLKIT_INTERFACE "'>"
+	"    <method name='CheckAuthorization'>"
+	"      <arg type='(sa{sv})' name='subject' direction='in'/>"
+	"      <arg type='s' name='action_id' direction='in'/>"
+	"      <arg type='a{ss}' name='details' direction='in'/>"
+	"      <arg type='u' name='flags' direction='in'/>"
+	"      <arg type='s' name='cancellation_id' direction='in'/>"
+	"      <arg type='(bba{ss})' name='result' direction='out'/>"
+	"    </method>"
+	"    <signal name='Changed'/>"
+	"  </interface>"
+	"</node>";
+
+typedef struct {
+	GDBusConnection *polkit_connection;
+	guint n_calls;
+
+	/* the answer of the mock polkit. */
+	gboolean is_authorized;
+	gboolean is_challenge;
+
+	/* if set, the calls are not answered right away. */
+	gboolean defer_reply;
+	GDBusMethodInvocation *deferred_invocation;
+
+	guint n_changed;
+} TestData;
+
+static void
+_polkit_method_call (GDBusConnection *connection,
+                     const char *sender,
+                     const char *object_path,
+                     const char *interface_name,
+                     const char *method_name,
+                     GVariant *parameters,
+                     GDBusMethodInvocation *invocation,
+                     gpointer user_data)
+{
+	TestData *tdata = user_data;
+
+	g_assert_cmpstr (method_name, ==, "CheckAuthorization");
+
+	tdata->n_calls++;
+
+	if (tdata->defer_reply) {
+		g_assert (!tdata->deferred_invocation);
+		tdata->deferred_invocation = invocation;
+		return;
+	}
+
+	g_dbus_method_invocation_return_value (invocation,
+	                                       g_variant_new ("((bb@a{ss}))",
+	                                                      tdata->is_authorized,
+	                                                      tdata->is_challenge,
+	                                                      g_variant_new_array (G_VARIANT_TYPE ("{ss}"), NULL, 0)));
+}
+
+static const GDBusInterfaceVTable polkit_vtable = {
+	.method_call = _polkit_method_call,
+};
+
+static void
+_polkit_emit_changed (TestData *tdata)
+{
+	guint n_changed = tdata->n_changed;
+
+	g_dbus_connection_emit_signal (tdata->polkit_connection,
+	                               NULL,
+	                               POLKIT_OBJECT_PATH,
+	                               POLKIT_INTERFACE,
+	                               "Changed",
+	                               NULL,
+	                               NULL);
+	nmtst_main_context_iterate_until_assert (NULL, 5000, tdata->n_changed > n_changed);
+}
+
+static void
+_auth_changed_cb (NMAuthManager *auth_manager, gpointer user_data)
+{
+	TestData *tdata = user_data;
+
+	tdata->n_changed++;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	gboolean done;
+	gboolean is_authorized;
+} CheckData;
+
+static void
+_check_cb (NMAuthManager *auth_manager,
+           NMAuthManagerCallId *call_id,
+           gboolean is_authorized,
+           gboolean is_challenge,
+           GError *error,
+           gpointer user_data)
+{
+	CheckData *check_data = user_data;
+
+	g_assert_no_error (error);
+	check_data->done = TRUE;
+	check_data->is_authorized = is_authorized;
+}
+
+static void
+_check_start (NMAuthSubject *subject,
+              const char *action_id,
+              gboolean allow_user_interaction,
+              CheckData *check_data)
+{
+	*check_data = (CheckData) { };
+	g_assert (nm_auth_manager_check_authorization (nm_auth_manager_get (),
+	                                               subject,
+	                                               action_id,
+	                                               allow_user_interaction,
+	                                               _check_cb,
+	                                               check_data));
+}
+
+/* checks @action_id and asserts on the answer and on whether the mock
+ * polkit was asked. */
+static void
+_check (TestData *tdata,
+        NMAuthSubject *subject,
+        const char *action_id,
+        gboolean allow_user_interaction,
+        gboolean expect_authorized,
+        gboolean expect_polkit_call)
+{
+	CheckData check_data;
+	guint n_calls = tdata->n_calls;
+
+	_check_start (subject, action_id, allow_user_interaction, &check_data);
+	nmtst_main_context_iterate_until_assert (NULL, 5000, check_data.done);
+
+	g_assert_cmpint (check_data.is_authorized, ==, expect_authorized);
+	g_assert_cmpint (tdata->n_calls, ==, n_calls + (expect_polkit_call ? 1 : 0));
+}
+
+/*****************************************************************************/
+
+static void
+test_auth_cache (void)
+{
+	gs_unref_object NMAuthSubject *subject = NULL;
+	gs_free_error GError *error = NULL;
+	gs_free char *dbus_daemon = NULL;
+	GDBusNodeInfo *node_info;
+	TestData tdata_stack = { };
+	TestData *const tdata = &tdata_stack;
+	CheckData check_data;
+	GTestDBus *bus;
+	GVariant *ret;
+	guint registration_id;
+	gulong changed_id;
+
+	dbus_daemon = g_find_program_in_path ("dbus-daemon");
+	if (!dbus_daemon) {
+		g_test_skip ("dbus-daemon is not available");
+		return;
+	}
+
+	bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+	g_test_dbus_up (bus);
+	g_setenv ("DBUS_SYSTEM_BUS_ADDRESS", g_test_dbus_get_bus_address (bus), TRUE);
+
+	/* the mock polkit. */
+	tdata->polkit_connection = g_dbus_connection_new_for_address_sync (g_test_dbus_get_bus_address (bus),
+	                                                                     G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT
+	                                                                   | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+	                                                                   NULL,
+	                                                                   NULL,
+	                                                                   &error);
+	nmtst_assert_success (tdata->polkit_connection, error);
+	node_info = g_dbus_node_info_new_for_xml (polkit_introspection_xml, &error);
+	nmtst_assert_success (node_info, error);
+	registration_id = g_dbus_connection_register_object (tdata->polkit_connection,
+	                                                     POLKIT_OBJECT_PATH,
+	                                                     node_info->interfaces[0],
+	                                                     &polkit_vtable,
+	                                                     tdata,
+	                                                     NULL,
+	                                                     &error);
+	nmtst_assert_success (registration_id, error);
+	g_dbus_node_info_unref (node_info);
+	ret = g_dbus_connection_call_sync (tdata->polkit_connection,
+	                                   "org.freedesktop.DBus",
+	                                   "/org/freedesktop/DBus",
+	                                   "org.freedesktop.DBus",
+	                                   "RequestName",
+	                                   g_variant_new ("(su)", POLKIT_SERVICE, 0u),
+	                                   G_VARIANT_TYPE ("(u)"),
+	                                   G_DBUS_CALL_FLAGS_NONE,
+	                                   -1,
+	                                   NULL,
+	                                   &error);
+	nmtst_assert_success (ret, error);
+	g_variant_unref (ret);
+
+	g_assert (nm_dbus_manager_acquire_bus (nm_dbus_manager_get (), TRUE));
+	nm_auth_manager_setup (NM_AUTH_POLKIT_MODE_USE_POLKIT);
+	changed_id = g_signal_connect (nm_auth_manager_get (),
+	                               NM_AUTH_MANAGER_SIGNAL_CHANGED,
+	                               G_CALLBACK (_auth_changed_cb),
+	                               tdata);
+
+	/* a non-root user, so that polkit gets asked. */
+	subject = nm_auth_subject_new_unix_process (":1.42", getpid (), 1000);
+
+	tdata->is_authorized = TRUE;
+
+	/* non-interactive answers are cached. They are also used for
+	 * interactive requests. */
+	_check (tdata, subject, "test.action.a", FALSE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.a", FALSE, TRUE, FALSE);
+	_check (tdata, subject, "test.action.a", TRUE, TRUE, FALSE);
+
+	/* interactive answers are not cached. */
+	_check (tdata, subject, "test.action.b", TRUE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.b", TRUE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.b", FALSE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.b", FALSE, TRUE, FALSE);
+
+	/* challenges are not cached. */
+	tdata->is_authorized = FALSE;
+	tdata->is_challenge = TRUE;
+	_check (tdata, subject, "test.action.c", FALSE, FALSE, TRUE);
+	_check (tdata, subject, "test.action.c", FALSE, FALSE, TRUE);
+
+	/* definite denials are cached. */
+	tdata->is_challenge = FALSE;
+	_check (tdata, subject, "test.action.d", FALSE, FALSE, TRUE);
+	_check (tdata, subject, "test.action.d", FALSE, FALSE, FALSE);
+
+	/* the "Changed" signal of polkit drops the cache. */
+	tdata->is_authorized = TRUE;
+	_polkit_emit_changed (tdata);
+	_check (tdata, subject, "test.action.a", FALSE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.d", FALSE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.d", FALSE, TRUE, FALSE);
+
+	/* an answer to a request that was pending while polkit changed is
+	 * not cached, because it might be outdated. */
+	tdata->defer_reply = TRUE;
+	_check_start (subject, "test.action.e", FALSE, &check_data);
+	nmtst_main_context_iterate_until_assert (NULL, 5000, tdata->deferred_invocation);
+	_polkit_emit_changed (tdata);
+	g_dbus_method_invocation_return_value (g_steal_pointer (&tdata->deferred_invocation),
+	                                       g_variant_new ("((bb@a{ss}))",
+	                                                      TRUE,
+	                                                      FALSE,
+	                                                      g_variant_new_array (G_VARIANT_TYPE ("{ss}"), NULL, 0)));
+	nmtst_main_context_iterate_until_assert (NULL, 5000, check_data.done);
+	g_assert (check_data.is_authorized);
+	tdata->defer_reply = FALSE;
+	_check (tdata, subject, "test.action.e", FALSE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.e", FALSE, TRUE, FALSE);
+
+	/* cached answers expire. */
+	nmtst_auth_manager_set_cache_ttl (nm_auth_manager_get (), 50);
+	_check (tdata, subject, "test.action.f", FALSE, TRUE, TRUE);
+	_check (tdata, subject, "test.action.f", FALSE, TRUE, FALSE);
+	g_usleep (100 * 1000);
+	_check (tdata, subject, "test.action.f", FALSE, TRUE, TRUE);
+
+	g_signal_handler_disconnect (nm_auth_manager_get (), changed_id);
+	g_dbus_connection_unregister_object (tdata->polkit_connection, registration_id);
+	g_object_unref (tdata->polkit_connection);
+
+	g_test_dbus_down (bus);
+	g_object_unref (bus);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE ();
+
+int
+main (int argc, char **argv)
+{
+	nmtst_init_with_logging (&argc, &argv, NULL, "ALL");
+
+	g_test_add_func ("/auth-manager/cache", test_auth_cache);
+
+	return g_test_run ();
+}
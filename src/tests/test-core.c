@@ -1093,20 +1093,40 @@ test_connection_sort_autoconnect_priority (void)
 static NMMatchSpecMatchType
 _test_match_spec_device (const GSList *specs, const char *match_str)
 {
+	NMMatchSpecDevice *match_spec;
+	NMMatchSpecMatchType m;
+	NMMatchSpecMatchType m2;
+	gs_free char *s = NULL;
+	const char *interface_name = NULL;
+	const char *driver = NULL;
+	const char *driver_version = NULL;
+	const char *s390_subchannels = NULL;
+
 	if (match_str && g_str_has_prefix (match_str, MATCH_S390))
-		return nm_match_spec_device (specs, NULL, NULL, NULL, NULL, NULL, &match_str[NM_STRLEN (MATCH_S390)], NULL);
-	if (match_str && g_str_has_prefix (match_str, MATCH_DRIVER)) {
-		gs_free char *s = g_strdup (&match_str[NM_STRLEN (MATCH_DRIVER)]);
+		s390_subchannels = &match_str[NM_STRLEN (MATCH_S390)];
+	else if (match_str && g_str_has_prefix (match_str, MATCH_DRIVER)) {
 		char *t;
 
+		s = g_strdup (&match_str[NM_STRLEN (MATCH_DRIVER)]);
 		t = strchr (s, '|');
 		if (t) {
 			t[0] = '\0';
 			t++;
 		}
-		return nm_match_spec_device (specs, NULL, NULL, s, t, NULL, NULL, NULL);
-	}
-	return nm_match_spec_device (specs, match_str, NULL, NULL, NULL, NULL, NULL, NULL);
+		driver = s;
+		driver_version = t;
+	} else
+		interface_name = match_str;
+
+	m = nm_match_spec_device (specs, interface_name, NULL, driver, driver_version, NULL, s390_subchannels, NULL);
+
+	/* the compiled specs must give the same result. */
+	match_spec = nm_match_spec_device_new (specs);
+	m2 = nm_match_spec_device_match (match_spec, interface_name, NULL, driver, driver_version, NULL, s390_subchannels, NULL);
+	nm_match_spec_device_free (match_spec);
+	g_assert_cmpint (m, ==, m2);
+
+	return m;
 }
 
 static void
@@ -0,0 +1,522 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Copyright (C) 2020 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "nm-dbus-manager.h"
+#include "nm-dbus-object.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+#define TEST_DBUS_INTERFACE NM_DBUS_INTERFACE".TestNotify"
+
+#define NM_TYPE_TEST_DBUS_OBJECT (nm_test_dbus_object_get_type ())
+#define NM_TEST_DBUS_OBJECT(obj) (G_TYPE_CHECK_INSTANCE_CAST ((obj), NM_TYPE_TEST_DBUS_OBJECT, NMTestDBusObject))
+
+#define NM_TEST_DBUS_OBJECT_VALUE "value"
+
+typedef struct {
+	NMDBusObject parent;
+	guint value;
+} NMTestDBusObject;
+
+typedef struct {
+	NMDBusObjectClass parent;
+} NMTestDBusObjectClass;
+
+static GType nm_test_dbus_object_get_type (void);
+
+G_DEFINE_TYPE (NMTestDBusObject, nm_test_dbus_object, NM_TYPE_DBUS_OBJECT)
+
+NM_GOBJECT_PROPERTIES_DEFINE (NMTestDBusObject,
+	PROP_VALUE,
+);
+
+static const NMDBusInterfaceInfoExtended interface_info_test;
+static const GDBusSignalInfo signal_info_ping;
+
+static void
+_set_value (NMTestDBusObject *self, guint value)
+{
+	if (self->value != value) {
+		self->value = value;
+		_notify (self, PROP_VALUE);
+	}
+}
+
+static void
+impl_test_set_value (NMDBusObject *obj,
+                     const NMDBusInterfaceInfoExtended *interface_info,
+                     const NMDBusMethodInfoExtended *method_info,
+                     GDBusConnection *connection,
+                     const char *sender,
+                     GDBusMethodInvocation *invocation,
+                     GVariant *parameters)
+{
+	guint32 value;
+
+	g_variant_get (parameters, "(u)", &value);
+	_set_value (NM_TEST_DBUS_OBJECT (obj), value);
+	g_dbus_method_invocation_return_value (invocation, NULL);
+}
+
+typedef struct {
+	NMTestDBusObject *obj;
+	GDBusMethodInvocation *invocation;
+	guint value;
+} SetValueLaterData;
+
+static gboolean
+_set_value_later_cb (gpointer user_data)
+{
+	SetValueLaterData *data = user_data;
+
+	_set_value (data->obj, data->value);
+	g_dbus_method_invocation_return_value (data->invocation, NULL);
+	g_object_unref (data->obj);
+	g_slice_free (SetValueLaterData, data);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+impl_test_set_value_later (NMDBusObject *obj,
+                           const NMDBusInterfaceInfoExtended *interface_info,
+                           const NMDBusMethodInfoExtended *method_info,
+                           GDBusConnection *connection,
+                           const char *sender,
+                           GDBusMethodInvocation *invocation,
+                           GVariant *parameters)
+{
+	SetValueLaterData *data;
+
+	/* like most handlers, reply asynchronously. */
+	data = g_slice_new (SetValueLaterData);
+	data->obj = g_object_ref (NM_TEST_DBUS_OBJECT (obj));
+	data->invocation = invocation;
+	g_variant_get (parameters, "(u)", &data->value);
+	g_timeout_add (10, _set_value_later_cb, data);
+}
+
+static void
+get_property (GObject *object, guint prop_id,
+              GValue *value, GParamSpec *pspec)
+{
+	NMTestDBusObject *self = NM_TEST_DBUS_OBJECT (object);
+
+	switch (prop_id) {
+	case PROP_VALUE:
+		g_value_set_uint (value, self->value);
+		break;
+	default:
+		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+		break;
+	}
+}
+
+static void
+nm_test_dbus_object_init (NMTestDBusObject *self)
+{
+}
+
+static const GDBusSignalInfo signal_info_ping = NM_DEFINE_GDBUS_SIGNAL_INFO_INIT (
+	"Ping",
+);
+
+static const NMDBusInterfaceInfoExtended interface_info_test = {
+	.parent = NM_DEFINE_GDBUS_INTERFACE_INFO_INIT (
+		TEST_DBUS_INTERFACE,
+		.methods = NM_DEFINE_GDBUS_METHOD_INFOS (
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"SetValue",
+					.in_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("value", "u"),
+					),
+				),
+				.handle = impl_test_set_value,
+			),
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"SetValueLater",
+					.in_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("value", "u"),
+					),
+				),
+				.handle = impl_test_set_value_later,
+			),
+		),
+		.signals = NM_DEFINE_GDBUS_SIGNAL_INFOS (
+			&signal_info_ping,
+		),
+		.properties = NM_DEFINE_GDBUS_PROPERTY_INFOS (
+			NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE ("Value", "u", NM_TEST_DBUS_OBJECT_VALUE),
+		),
+	),
+};
+
+static void
+nm_test_dbus_object_class_init (NMTestDBusObjectClass *klass)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (klass);
+	NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS (klass);
+
+	dbus_object_class->export_path = NM_DBUS_EXPORT_PATH_NUMBERED (NM_DBUS_PATH"/TestNotify");
+	dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS (&interface_info_test);
+
+	object_class->get_property = get_property;
+
+	obj_properties[PROP_VALUE] =
+	    g_param_spec_uint (NM_TEST_DBUS_OBJECT_VALUE, "", "",
+	                       0, G_MAXUINT32, 0,
+	                       G_PARAM_READABLE |
+	                       G_PARAM_STATIC_STRINGS);
+
+	g_object_class_install_properties (object_class, _PROPERTY_ENUMS_LAST, obj_properties);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	GDBusConnection *client;
+	GPtrArray *events;
+	guint subscription_id;
+} TestData;
+
+static void
+_signal_cb (GDBusConnection *connection,
+            const char *sender_name,
+            const char *object_path,
+            const char *interface_name,
+            const char *signal_name,
+            GVariant *parameters,
+            gpointer user_data)
+{
+	TestData *tdata = user_data;
+	char *event;
+
+	if (nm_streq (signal_name, "PropertiesChanged")) {
+		gs_unref_variant GVariant *changed = NULL;
+		const char *iface;
+		guint32 value;
+
+		g_variant_get (parameters, "(&s@a{sv}as)", &iface, &changed, NULL);
+		if (!nm_streq (iface, TEST_DBUS_INTERFACE))
+			return;
+		g_assert (g_variant_lookup (changed, "Value", "u", &value));
+		event = g_strdup_printf ("PropertiesChanged:%u", (guint) value);
+	} else if (NM_IN_STRSET (signal_name, "InterfacesAdded", "InterfacesRemoved", "Ping"))
+		event = g_strdup (signal_name);
+	else
+		return;
+
+	g_ptr_array_add (tdata->events, event);
+}
+
+static void
+_set_value_cb (GObject *source,
+               GAsyncResult *result,
+               gpointer user_data)
+{
+	TestData *tdata = user_data;
+	gs_unref_variant GVariant *ret = NULL;
+	gs_free_error GError *error = NULL;
+
+	ret = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), result, &error);
+	nmtst_assert_success (ret, error);
+	g_ptr_array_add (tdata->events, g_strdup ("reply:SetValue"));
+}
+
+static void
+_get_value_cb (GObject *source,
+               GAsyncResult *result,
+               gpointer user_data)
+{
+	TestData *tdata = user_data;
+	gs_unref_variant GVariant *ret = NULL;
+	gs_unref_variant GVariant *value = NULL;
+	gs_free_error GError *error = NULL;
+
+	ret = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), result, &error);
+	nmtst_assert_success (ret, error);
+	g_variant_get (ret, "(v)", &value);
+	g_ptr_array_add (tdata->events, g_strdup_printf ("reply:Get:%u", (guint) g_variant_get_uint32 (value)));
+}
+
+static void
+_call (TestData *tdata,
+       const char *path,
+       const char *interface,
+       const char *method,
+       GVariant *parameters,
+       GAsyncReadyCallback callback)
+{
+	g_dbus_connection_call (tdata->client,
+	                        NM_DBUS_SERVICE,
+	                        path,
+	                        interface,
+	                        method,
+	                        parameters,
+	                        NULL,
+	                        G_DBUS_CALL_FLAGS_NONE,
+	                        -1,
+	                        NULL,
+	                        callback,
+	                        tdata);
+}
+
+static void
+_wait_for_event (TestData *tdata, const char *event)
+{
+	nmtst_main_context_iterate_until_assert (NULL,
+	                                         5000,
+	                                            tdata->events->len > 0
+	                                         && nm_streq (tdata->events->pdata[tdata->events->len - 1], event));
+}
+
+static void
+_wait_for_n_events (TestData *tdata, guint n)
+{
+	nmtst_main_context_iterate_until_assert (NULL, 5000, tdata->events->len >= n);
+}
+
+static void
+_assert_events (TestData *tdata, const char *expected)
+{
+	gs_free char *joined = NULL;
+
+	g_ptr_array_add (tdata->events, NULL);
+	joined = g_strjoinv (",", (char **) tdata->events->pdata);
+	g_ptr_array_set_size (tdata->events, 0);
+	g_assert_cmpstr (joined, ==, expected);
+}
+
+static GTestDBus *gl_bus;
+
+static GDBusConnection *
+_client_new (void)
+{
+	gs_free_error GError *error = NULL;
+	GDBusConnection *client;
+
+	client = g_dbus_connection_new_for_address_sync (g_test_dbus_get_bus_address (gl_bus),
+	                                                   G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT
+	                                                 | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+	                                                 NULL,
+	                                                 NULL,
+	                                                 &error);
+	nmtst_assert_success (client, error);
+	return client;
+}
+
+static void
+test_notify_order (void)
+{
+	gs_unref_object NMTestDBusObject *obj = NULL;
+	TestData tdata_stack = { };
+	TestData *const tdata = &tdata_stack;
+	const char *path;
+
+	if (!gl_bus) {
+		g_test_skip ("dbus-daemon is not available");
+		return;
+	}
+
+	tdata->events = g_ptr_array_new_with_free_func (g_free);
+	tdata->client = _client_new ();
+	tdata->subscription_id = g_dbus_connection_signal_subscribe (tdata->client,
+	                                                             NULL,
+	                                                             NULL,
+	                                                             NULL,
+	                                                             NULL,
+	                                                             NULL,
+	                                                             G_DBUS_SIGNAL_FLAGS_NONE,
+	                                                             _signal_cb,
+	                                                             tdata,
+	                                                             NULL);
+
+	obj = g_object_new (NM_TYPE_TEST_DBUS_OBJECT, NULL);
+	path = nm_dbus_object_export (NM_DBUS_OBJECT (obj));
+	_wait_for_event (tdata, "InterfacesAdded");
+	_assert_events (tdata, "InterfacesAdded");
+
+	/* the two changes are merged into one signal, which is emitted before
+	 * the next signal of the object. The last change is emitted before
+	 * the object is removed. */
+	_set_value (obj, 1);
+	_set_value (obj, 2);
+	nm_dbus_object_emit_signal (NM_DBUS_OBJECT (obj), &interface_info_test, &signal_info_ping, "()");
+	_set_value (obj, 3);
+	_wait_for_event (tdata, "PropertiesChanged:3");
+	_assert_events (tdata, "PropertiesChanged:2,Ping,PropertiesChanged:3");
+
+	/* while the signal is still queued, Get already returns the new value. */
+	_call (tdata, path, "org.freedesktop.DBus.Properties", "Get",
+	       g_variant_new ("(ss)", TEST_DBUS_INTERFACE, "Value"),
+	       _get_value_cb);
+	_wait_for_event (tdata, "reply:Get:3");
+	_assert_events (tdata, "reply:Get:3");
+	_set_value (obj, 6);
+	_call (tdata, path, "org.freedesktop.DBus.Properties", "Get",
+	       g_variant_new ("(ss)", TEST_DBUS_INTERFACE, "Value"),
+	       _get_value_cb);
+	_wait_for_n_events (tdata, 2);
+	g_assert (nm_utils_strv_find_first ((char **) tdata->events->pdata, tdata->events->len, "reply:Get:6") >= 0);
+	g_assert (nm_utils_strv_find_first ((char **) tdata->events->pdata, tdata->events->len, "PropertiesChanged:6") >= 0);
+	g_ptr_array_set_size (tdata->events, 0);
+
+	/* a property that changed while handling a method call is emitted
+	 * before the reply. */
+	_call (tdata, path, TEST_DBUS_INTERFACE, "SetValue",
+	       g_variant_new ("(u)", 4u),
+	       _set_value_cb);
+	_wait_for_event (tdata, "reply:SetValue");
+	_assert_events (tdata, "PropertiesChanged:4,reply:SetValue");
+
+	/* also, when the handler replies later. */
+	_call (tdata, path, TEST_DBUS_INTERFACE, "SetValueLater",
+	       g_variant_new ("(u)", 7u),
+	       _set_value_cb);
+	_wait_for_event (tdata, "reply:SetValue");
+	_assert_events (tdata, "PropertiesChanged:7,reply:SetValue");
+
+	_set_value (obj, 5);
+	nm_dbus_object_unexport (NM_DBUS_OBJECT (obj));
+	_wait_for_event (tdata, "InterfacesRemoved");
+	_assert_events (tdata, "PropertiesChanged:5,InterfacesRemoved");
+
+	g_dbus_connection_signal_unsubscribe (tdata->client, tdata->subscription_id);
+	g_ptr_array_unref (tdata->events);
+	g_object_unref (tdata->client);
+}
+
+/*****************************************************************************/
+
+#define BENCH_N_OBJECTS 10000
+
+static void
+_obj_unexport_and_unref (gpointer data)
+{
+	nm_dbus_object_unexport (data);
+	g_object_unref (data);
+}
+
+static void
+_get_managed_objects_cb (GObject *source,
+                         GAsyncResult *result,
+                         gpointer user_data)
+{
+	GVariant **p_ret = user_data;
+	gs_free_error GError *error = NULL;
+
+	*p_ret = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), result, &error);
+	nmtst_assert_success (*p_ret, error);
+}
+
+static void
+test_export_many (void)
+{
+	gs_unref_object GDBusConnection *client = NULL;
+	gs_unref_ptrarray GPtrArray *objs = NULL;
+	guint i, k;
+
+	if (!gl_bus) {
+		g_test_skip ("dbus-daemon is not available");
+		return;
+	}
+
+	client = _client_new ();
+	objs = g_ptr_array_new_full (BENCH_N_OBJECTS, _obj_unexport_and_unref);
+
+	g_test_timer_start ();
+	for (i = 0; i < BENCH_N_OBJECTS; i++) {
+		NMDBusObject *obj;
+
+		obj = g_object_new (NM_TYPE_TEST_DBUS_OBJECT, NULL);
+		nm_dbus_object_export (obj);
+		g_ptr_array_add (objs, obj);
+	}
+	g_test_timer_elapsed ();
+	g_test_message ("export %u objects: %f seconds", BENCH_N_OBJECTS, g_test_timer_last ());
+
+	/* the server runs on our main context, so call it asynchronously. */
+	for (k = 0; k < 3; k++) {
+		gs_unref_variant GVariant *ret = NULL;
+		gs_unref_variant GVariant *objects = NULL;
+
+		g_test_timer_start ();
+		g_dbus_connection_call (client,
+		                        NM_DBUS_SERVICE,
+		                        "/org/freedesktop",
+		                        DBUS_INTERFACE_OBJECT_MANAGER,
+		                        "GetManagedObjects",
+		                        NULL,
+		                        G_VARIANT_TYPE ("(a{oa{sa{sv}}})"),
+		                        G_DBUS_CALL_FLAGS_NONE,
+		                        -1,
+		                        NULL,
+		                        _get_managed_objects_cb,
+		                        &ret);
+		nmtst_main_context_iterate_until_assert (NULL, 30000, ret);
+		g_test_timer_elapsed ();
+
+		objects = g_variant_get_child_value (ret, 0);
+		g_assert_cmpint (g_variant_n_children (objects), >=, BENCH_N_OBJECTS);
+
+		g_test_message ("GetManagedObjects #%u with %u objects: %f seconds",
+		                k,
+		                BENCH_N_OBJECTS,
+		                g_test_timer_last ());
+		if (g_test_perf ()) {
+			g_test_minimized_result (g_test_timer_last (),
+			                         "GetManagedObjects with %u objects: %f seconds",
+			                         BENCH_N_OBJECTS,
+			                         g_test_timer_last ());
+		}
+	}
+
+	g_test_timer_start ();
+	g_ptr_array_set_size (objs, 0);
+	g_test_timer_elapsed ();
+	g_test_message ("unexport %u objects: %f seconds", BENCH_N_OBJECTS, g_test_timer_last ());
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE ();
+
+int
+main (int argc, char **argv)
+{
+	gs_free char *dbus_daemon = NULL;
+	int result;
+
+	nmtst_init_with_logging (&argc, &argv, NULL, "ALL");
+
+	/* the NMDBusManager singleton can only acquire the bus once, so all
+	 * tests share one bus. */
+	dbus_daemon = g_find_program_in_path ("dbus-daemon");
+	if (dbus_daemon) {
+		gl_bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+		g_test_dbus_up (gl_bus);
+		g_setenv ("DBUS_SYSTEM_BUS_ADDRESS", g_test_dbus_get_bus_address (gl_bus), TRUE);
+
+		g_assert (nm_dbus_manager_acquire_bus (nm_dbus_manager_get (), TRUE));
+		nm_dbus_manager_start (nm_dbus_manager_get (), NULL, NULL);
+	}
+
+	g_test_add_func ("/dbus-manager/notify-order", test_notify_order);
+	g_test_add_func ("/dbus-manager/export-many", test_export_many);
+
+	result = g_test_run ();
+
+	if (gl_bus) {
+		g_test_dbus_down (gl_bus);
+		g_clear_object (&gl_bus);
+	}
+
+	return result;
+}
@@ -1686,7 +1686,23 @@ class Settings(ExportedObj):
     def AddConnection(self, con_hash):
         return self.add_connection(con_hash)
 
-    def add_connection(self, con_hash, do_verify_strict=True):
+    @dbus.service.method(dbus_interface=IFACE_SETTINGS, in_signature='aa{sa{sv}}ua{sv}', out_signature='aa{sv}')
+    def AddConnections(self, con_hashes, flags, args):
+        # Like NetworkManager, every profile succeeds or fails on its own,
+        # NewConnection is emitted in the order of the request, and the
+        # Connections property changes only once.
+        results = []
+        for con_hash in con_hashes:
+            try:
+                path = self.add_connection(con_hash, notify_connections=False)
+            except dbus.exceptions.DBusException as e:
+                results.append(dbus.Dictionary({ 'error': dbus.String(e.get_dbus_message()) }, signature='sv'))
+            else:
+                results.append(dbus.Dictionary({ 'path': dbus.ObjectPath(path) }, signature='sv'))
+        self._dbus_property_set(IFACE_SETTINGS, PRP_SETTINGS_CONNECTIONS, dbus.Array(self.get_connection_paths(), 'o'))
+        return dbus.Array(results, 'a{sv}')
+
+    def add_connection(self, con_hash, do_verify_strict=True, notify_connections=True):
         self.c_counter += 1
         con_inst = Connection(self.c_counter, con_hash, do_verify_strict)
 
@@ -1697,7 +1713,8 @@ class Settings(ExportedObj):
         con_inst.export()
         self.connections[con_inst.path] = con_inst
         self.NewConnection(con_inst.path)
-        self._dbus_property_set(IFACE_SETTINGS, PRP_SETTINGS_CONNECTIONS, dbus.Array(self.get_connection_paths(), 'o'))
+        if notify_connections:
+            self._dbus_property_set(IFACE_SETTINGS, PRP_SETTINGS_CONNECTIONS, dbus.Array(self.get_connection_paths(), 'o'))
 
         gl.manager.devices_available_connections_update()
 